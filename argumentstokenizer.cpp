@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "argumentstokenizer.h"
+
+namespace QuasarAppUtils {
+
+static inline bool isSpace(char symbol) {
+    return symbol == ' ' || symbol == '\t' || symbol == '\n' || symbol == '\r' || symbol == '\f' || symbol == '\v';
+}
+
+ArgumentsTokenizer::ArgumentsTokenizer(QByteArrayView data):
+    _data(data) {
+}
+
+ArgumentsTokenizer::~ArgumentsTokenizer() {
+    close();
+}
+
+bool ArgumentsTokenizer::open(const QString &path) {
+    close();
+
+    _file.setFileName(path);
+    if (!_file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const qint64 size = _file.size();
+    if (size > 0) {
+        _mapped = _file.map(0, size);
+    }
+
+    if (_mapped) {
+        _data = QByteArrayView(reinterpret_cast<const char*>(_mapped), size);
+    } else {
+        _buffer = _file.readAll();
+        _data = _buffer;
+    }
+
+    // skip the utf-8 BOM
+    if (_data.startsWith("\xEF\xBB\xBF")) {
+        _pos = 3;
+    }
+
+    return true;
+}
+
+void ArgumentsTokenizer::close() {
+    if (_mapped) {
+        _file.unmap(_mapped);
+        _mapped = nullptr;
+    }
+
+    if (_file.isOpen()) {
+        _file.close();
+    }
+
+    _buffer.clear();
+    _data = {};
+    _pos = 0;
+}
+
+void ArgumentsTokenizer::skipSpaces() {
+    const qsizetype size = _data.size();
+    while (_pos < size) {
+        const char symbol = _data[_pos];
+
+        if (isSpace(symbol)) {
+            ++_pos;
+            continue;
+        }
+
+        // the comment continues until the end of the line.
+        if (symbol == '#') {
+            const qsizetype end = _data.indexOf('\n', _pos);
+            _pos = (end < 0)? size: end + 1;
+            continue;
+        }
+
+        break;
+    }
+}
+
+bool ArgumentsTokenizer::next(QByteArrayView *token) {
+    skipSpaces();
+
+    const qsizetype size = _data.size();
+    if (_pos >= size) {
+        return false;
+    }
+
+    const qsizetype begin = _pos;
+
+    // fast path: the token without quotes and escapes is a view of the source data.
+    while (_pos < size) {
+        const char symbol = _data[_pos];
+        if (isSpace(symbol) || symbol == '"' || symbol == '\'' || symbol == '\\') {
+            break;
+        }
+        ++_pos;
+    }
+
+    if (_pos >= size || isSpace(_data[_pos])) {
+        *token = _data.sliced(begin, _pos - begin);
+        return true;
+    }
+
+    // slow path: the token will be unquoted into the scratch buffer.
+    _scratch.clear();
+    _scratch.append(_data.sliced(begin, _pos - begin));
+
+    char quote = 0;
+    while (_pos < size) {
+        const char symbol = _data[_pos];
+
+        if (quote) {
+            if (symbol == quote) {
+                quote = 0;
+            } else if (symbol == '\\' && quote == '"' && _pos + 1 < size) {
+                _scratch.append(_data[++_pos]);
+            } else {
+                _scratch.append(symbol);
+            }
+        } else if (isSpace(symbol)) {
+            break;
+        } else if (symbol == '"' || symbol == '\'') {
+            quote = symbol;
+        } else if (symbol == '\\' && _pos + 1 < size) {
+            _scratch.append(_data[++_pos]);
+        } else {
+            _scratch.append(symbol);
+        }
+
+        ++_pos;
+    }
+
+    *token = _scratch;
+    return true;
+}
+
+}
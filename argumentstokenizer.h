@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef ARGUMENTSTOKENIZER_H
+#define ARGUMENTSTOKENIZER_H
+
+#include "quasarapp_global.h"
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QFile>
+
+namespace QuasarAppUtils {
+
+/**
+ * @brief The ArgumentsTokenizer class splits the arguments file (response file or config) to tokens.
+ * The file is mapped into memory and readed by one pass, so the tokens are views to the mapped memory.
+ * The rules of the tokenizer:
+ *  * tokens are separated by whitespaces;
+ *  * "..." and '...' quotes keep whitespaces of the token;
+ *  * the \ symbol escapes the next symbol (except of the '...' quotes);
+ *  * the # symbol at the begin of the token starts a comment until the end of the line.
+ *
+ * Example of use :
+ *
+ *  @code{cpp}
+ *     QuasarAppUtils::ArgumentsTokenizer tokenizer;
+ *     if (tokenizer.open("app.args")) {
+ *         QByteArrayView token;
+ *         while (tokenizer.next(&token)) {
+ *             // token is valid until the next call of the next method.
+ *         }
+ *     }
+ *  @endcode
+ *
+ * @see Params::parseParams
+ */
+class QUASARAPPSHARED_EXPORT ArgumentsTokenizer
+{
+public:
+    ArgumentsTokenizer() = default;
+
+    /**
+     * @brief ArgumentsTokenizer This constructor creates tokenizer of the @a data.
+     * @param data This is text for split. The data should be valid while the tokenizer is used.
+     */
+    explicit ArgumentsTokenizer(QByteArrayView data);
+    ~ArgumentsTokenizer();
+
+    ArgumentsTokenizer(const ArgumentsTokenizer&) = delete;
+    ArgumentsTokenizer& operator=(const ArgumentsTokenizer&) = delete;
+
+    /**
+     * @brief open This method maps the file into memory and starts the tokenization of it.
+     *  If the file can not be mapped (for example it is a pipe) the file will be readed fully.
+     * @param path This is path to the file.
+     * @return true if the file opened successful else false.
+     */
+    bool open(const QString& path);
+
+    /**
+     * @brief next This method reads next token.
+     * @param token This is result token. The token is valid until the next call of this method.
+     * @return true if token readed else false (end of the data).
+     */
+    bool next(QByteArrayView* token);
+
+private:
+    void skipSpaces();
+    void close();
+
+    QFile _file;
+    uchar* _mapped = nullptr;
+    QByteArray _buffer;
+    QByteArray _scratch;
+    QByteArrayView _data;
+    qsizetype _pos = 0;
+};
+
+}
+#endif // ARGUMENTSTOKENIZER_H
@@ -0,0 +1,489 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "controlsocket.h"
+#include "isettings.h"
+#include "locales.h"
+#include "params.h"
+#include "qalogger.h"
+#include "startupprofiler.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QMutex>
+#include <QSemaphore>
+#include <QThread>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#ifdef Q_OS_UNIX
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define QA_CONTROL_SOCKET_SUPPORTED
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+// protection from the clients that send data without line breaks.
+#define MAX_COMMAND_LENGTH 4096
+#define MAX_CLIENTS 16
+// period of the checks of the stop request while the endpoint waits for other thread.
+#define WAIT_INTERVAL 100
+
+namespace QuasarAppUtils {
+
+namespace {
+
+/**
+ * @brief The ControlData struct contains state of the endpoint thread.
+ */
+struct ControlData {
+    QMutex lock;
+    QThread* thread = nullptr;
+    // the stop method holds the lock while waits for the thread, so this flag is readed without the lock.
+    QAtomicInt stopping = 0;
+    int listenFd = -1;
+    // the write end wakes up the thread while stopping.
+    int stopPipe[2] = {-1, -1};
+    QString path;
+};
+
+ControlData& controlData() {
+    static ControlData data;
+    return data;
+}
+
+QString helpMessage() {
+    return "help - prints this message\n"
+           "get key - prints value of the key\n"
+           "set key [value] - sets value of the key\n"
+           "loglevel [0 - 3] - prints or sets verbose level of the logger\n"
+           "flush - flushes the logs\n"
+           "metrics - prints startup phases and settings statistics\n"
+           "sync - saves settings\n"
+           "reloadcache - reloads cache of the settings\n"
+           "reload - reloads arguments of the application\n"
+           "locale [name] - prints or sets locale of the application\n"
+           "quit - closes the connection\n";
+}
+
+/**
+ * @brief The ControlCall struct is shared state of the call that invoked in other thread.
+ */
+struct ControlCall {
+    QSemaphore done;
+    QAtomicInt result = 0;
+};
+
+/**
+ * @brief invokeInThread This function invokes the @a function in the thread of the @a context object and waits for the result.
+ *  The waiting is interrupted when the endpoint is stopping, because the thread of the @a context may wait for the endpoint.
+ * @param result This is result of the @a function.
+ * @return true if the @a function is finished else false.
+ */
+bool invokeInThread(QObject* context, const std::function<bool()>& function, bool* result) {
+    QThread* thread = (context)? context->thread(): nullptr;
+    if (!thread || thread == QThread::currentThread() || !thread->isRunning()) {
+        *result = function();
+        return true;
+    }
+
+    auto call = std::make_shared<ControlCall>();
+    QMetaObject::invokeMethod(context, [function, call]() {
+        call->result.storeRelaxed(function());
+        call->done.release();
+    }, Qt::QueuedConnection);
+
+    while (!call->done.tryAcquire(1, WAIT_INTERVAL)) {
+        if (controlData().stopping.loadAcquire()) {
+            return false;
+        }
+    }
+
+    *result = call->result.loadRelaxed();
+    return true;
+}
+
+#ifdef QA_CONTROL_SOCKET_SUPPORTED
+
+/**
+ * @brief The ControlClient struct is connection of the endpoint with not completed command.
+ */
+struct ControlClient {
+    int fd = -1;
+    QByteArray buffer;
+};
+
+void setCloseOnExec(int fd) {
+    fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC);
+}
+
+bool sendAll(int fd, const QByteArray& data) {
+    qsizetype sent = 0;
+    while (sent < data.size()) {
+        const ssize_t result = send(fd, data.constData() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (result < 0) {
+            if (errno == EINTR)
+                continue;
+
+            return false;
+        }
+
+        sent += result;
+    }
+
+    return true;
+}
+
+/**
+ * @brief readClient This function reads data of the @a client and executes all received commands.
+ * @return false if the connection should be closed.
+ */
+bool readClient(ControlClient& client) {
+    char buffer[1024];
+    const ssize_t size = read(client.fd, buffer, sizeof(buffer));
+    if (size < 0) {
+        return errno == EINTR;
+    }
+
+    if (size == 0) {
+        return false;
+    }
+
+    client.buffer.append(buffer, size);
+
+    qsizetype end = -1;
+    while ((end = client.buffer.indexOf('\n')) >= 0) {
+        const QByteArray line = client.buffer.left(end).trimmed();
+        client.buffer.remove(0, end + 1);
+
+        if (line.isEmpty()) {
+            continue;
+        }
+
+        if (line == "quit") {
+            return false;
+        }
+
+        if (!sendAll(client.fd, ControlSocket::execute(QString::fromUtf8(line)).toUtf8())) {
+            return false;
+        }
+    }
+
+    if (client.buffer.size() > MAX_COMMAND_LENGTH) {
+        sendAll(client.fd, "ERROR command is too long\n");
+        return false;
+    }
+
+    return true;
+}
+
+void controlLoop(int listenFd, int stopFd) {
+    std::vector<ControlClient> clients;
+    std::vector<pollfd> fds;
+
+    while (true) {
+        fds.clear();
+        fds.push_back({stopFd, POLLIN, 0});
+        fds.push_back({listenFd, POLLIN, 0});
+        for (const auto& client : clients) {
+            fds.push_back({client.fd, POLLIN, 0});
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR)
+                continue;
+
+            qCritical() << "ControlSocket: poll failed, errno:" << errno;
+            break;
+        }
+
+        if (fds[0].revents) {
+            break;
+        }
+
+        // clients are processed from the end, so removing does not change indexes of the not processed clients.
+        for (size_t i = clients.size(); i-- > 0;) {
+            if (!fds[i + 2].revents) {
+                continue;
+            }
+
+            if (!readClient(clients[i])) {
+                close(clients[i].fd);
+                clients.erase(clients.begin() + i);
+            }
+        }
+
+        if (fds[1].revents & POLLIN) {
+            const int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) {
+                continue;
+            }
+
+            if (clients.size() >= MAX_CLIENTS) {
+                sendAll(fd, "ERROR too many connections\n");
+                close(fd);
+                continue;
+            }
+
+            setCloseOnExec(fd);
+            clients.push_back({fd, {}});
+        }
+    }
+
+    for (const auto& client : clients) {
+        close(client.fd);
+    }
+}
+
+/**
+ * @brief isSocketAlive This function return true if other process listens the @a address.
+ */
+bool isSocketAlive(const sockaddr_un& address) {
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    const bool alive = ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+    close(fd);
+    return alive;
+}
+
+#endif
+
+}
+
+bool ControlSocket::start(const QString &path) {
+#ifdef QA_CONTROL_SOCKET_SUPPORTED
+    auto& data = controlData();
+    QMutexLocker locker(&data.lock);
+
+    if (data.thread) {
+        qWarning() << "ControlSocket: the endpoint is already started on" << data.path;
+        return false;
+    }
+
+    const QByteArray localPath = path.toLocal8Bit();
+
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (localPath.isEmpty() || static_cast<size_t>(localPath.size()) >= sizeof(address.sun_path)) {
+        qCritical() << "ControlSocket: wrong path of the socket:" << path;
+        return false;
+    }
+
+    memcpy(address.sun_path, localPath.constData(), localPath.size());
+
+    struct stat info;
+    if (lstat(localPath.constData(), &info) == 0) {
+        if (!S_ISSOCK(info.st_mode) || isSocketAlive(address)) {
+            qCritical() << "ControlSocket: the path is already used:" << path;
+            return false;
+        }
+
+        // the socket file of the finished process.
+        unlink(localPath.constData());
+    }
+
+    data.listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (data.listenFd < 0) {
+        qCritical() << "ControlSocket: failed to create the socket, errno:" << errno;
+        return false;
+    }
+
+    setCloseOnExec(data.listenFd);
+
+    // the socket file should be created with 0600 permissions, so other users can not connect to it even for a moment.
+    const mode_t mask = umask(S_IRWXG | S_IRWXO | S_IXUSR);
+    const bool bound = bind(data.listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+    umask(mask);
+
+    if (!bound ||
+        listen(data.listenFd, MAX_CLIENTS) != 0 ||
+        pipe(data.stopPipe) != 0) {
+
+        qCritical() << "ControlSocket: failed to listen the" << path << "errno:" << errno;
+        close(data.listenFd);
+        data.listenFd = -1;
+        unlink(localPath.constData());
+        return false;
+    }
+
+    setCloseOnExec(data.stopPipe[0]);
+    setCloseOnExec(data.stopPipe[1]);
+
+    data.path = path;
+    data.stopping.storeRelease(0);
+
+    const int listenFd = data.listenFd;
+    const int stopFd = data.stopPipe[0];
+    data.thread = QThread::create([listenFd, stopFd]() {
+        controlLoop(listenFd, stopFd);
+    });
+
+    data.thread->setObjectName("ControlSocket");
+    data.thread->start();
+
+    return true;
+#else
+    Q_UNUSED(path)
+    qWarning() << "ControlSocket: the control socket is not supported on this platform.";
+    return false;
+#endif
+}
+
+void ControlSocket::stop() {
+#ifdef QA_CONTROL_SOCKET_SUPPORTED
+    auto& data = controlData();
+    QMutexLocker locker(&data.lock);
+
+    if (!data.thread) {
+        return;
+    }
+
+    data.stopping.storeRelease(1);
+
+    const char stopByte = 1;
+    if (write(data.stopPipe[1], &stopByte, 1) != 1) {
+        qWarning() << "ControlSocket: failed to wake up the endpoint thread.";
+    }
+
+    data.thread->wait();
+    delete data.thread;
+    data.thread = nullptr;
+
+    close(data.listenFd);
+    close(data.stopPipe[0]);
+    close(data.stopPipe[1]);
+    data.listenFd = -1;
+    data.stopPipe[0] = -1;
+    data.stopPipe[1] = -1;
+
+    unlink(data.path.toLocal8Bit().constData());
+    data.path.clear();
+#endif
+}
+
+bool ControlSocket::isActive() {
+    auto& data = controlData();
+    QMutexLocker locker(&data.lock);
+    return data.thread;
+}
+
+QString ControlSocket::execute(const QString &command) {
+    const QStringList args = command.split(' ', Qt::SkipEmptyParts);
+    if (args.isEmpty()) {
+        return "ERROR empty command\n";
+    }
+
+    const QString& name = args.first();
+    QString result;
+    QString error;
+
+    if (name == "help") {
+        result = helpMessage();
+
+    } else if (name == "get" && args.size() == 2) {
+        if (Params::hasValue(args[1])) {
+            result = args[1] + "=" + Params::value(args[1]) + "\n";
+        } else {
+            error = "the " + args[1] + " key is not found";
+        }
+
+    } else if (name == "set" && args.size() >= 2) {
+        Params::setArg(args[1], args.mid(2).join(' '));
+
+    } else if (name == "loglevel" && args.size() <= 2) {
+        if (args.size() == 1) {
+            result = QString::number(QALogger::verboseLevel()) + "\n";
+        } else {
+            bool ok = false;
+            const int lvl = args[1].toInt(&ok);
+            if (ok && lvl >= VerboseLvl::Error && lvl <= VerboseLvl::Debug) {
+                Params::setArg("verbose", args[1]);
+                QALogger::setVerboseLevel(static_cast<VerboseLvl>(lvl));
+            } else {
+                error = "the verbose level should be in range 0 - 3";
+            }
+        }
+
+    } else if (name == "flush" && args.size() == 1) {
+        QALogger::flush();
+
+    } else if (name == "metrics" && args.size() == 1) {
+        result = StartupProfiler::report() + "\n";
+        result += QString("Arguments: %0\n").arg(Params::snapshot().size());
+
+        auto settings = ISettings::instance();
+        if (settings && settings->isProfilingEnabled()) {
+            result += settings->profileReport() + "\n";
+        }
+
+    } else if ((name == "sync" || name == "reloadcache") && args.size() == 1) {
+        auto settings = ISettings::instance();
+        bool done = false;
+        if (!settings) {
+            error = "the settings service is not initialized";
+
+        // the cache of the settings is not thread-safe, so the command is executed in the thread of the settings object.
+        } else if (!invokeInThread(settings, [settings, sync = name == "sync"]() {
+                       if (sync) {
+                           settings->sync();
+                       } else {
+                           settings->forceReloadCache();
+                       }
+                       return true;
+                   }, &done)) {
+            error = "the endpoint is stopping";
+        }
+
+    } else if (name == "reload" && args.size() == 1) {
+        // the arguments are resolved with the settings, so they are reloaded in the main thread.
+        bool done = false;
+        if (!invokeInThread(QCoreApplication::instance(), []() {
+                return Params::reload();
+            }, &done)) {
+            error = "the endpoint is stopping";
+        } else if (!done) {
+            error = "failed to reload the arguments";
+        }
+
+    } else if (name == "locale" && args.size() <= 2) {
+        if (!Locales::isInit()) {
+            error = "the locales service is not initialized";
+        } else if (args.size() == 1) {
+            result = Locales::currentLocate().name() + "\n";
+        } else {
+            // translators are installed in the thread of the Locales object, so the event loop will apply the locale.
+            const QLocale locale(args[1]);
+            QMetaObject::invokeMethod(Locales::instance(), [locale]() {
+                Locales::setLocale(locale);
+            }, Qt::QueuedConnection);
+            result = "the " + locale.name() + " locale is queued\n";
+        }
+
+    } else {
+        error = "unknown command or wrong arguments, use the help command";
+    }
+
+    if (error.size()) {
+        return "ERROR " + error + "\n";
+    }
+
+    return result + "OK\n";
+}
+
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef CONTROLSOCKET_H
+#define CONTROLSOCKET_H
+
+#include "quasarapp_global.h"
+#include <QString>
+
+namespace QuasarAppUtils {
+
+/**
+ * @brief The ControlSocket class is optional admin endpoint of the application based on the unix domain socket.
+ * The endpoint allows to change log level, flush logs, print metrics and sync settings of the live process without restart.
+ * Commands are executed on the dedicated thread, so the endpoint never competes with the event loop of the application.
+ * Only the sync, reloadcache and reload commands are queued into the thread of the settings object and the main thread, and the endpoint waits for them.
+ *
+ * The protocol is text: one command per line, the response is lines of the result with the last line "OK" or "ERROR <message>".
+ * Available commands:
+ *  * **help** - prints list of the commands.
+ *  * **get** key - prints value of the key (see the Params::value method).
+ *  * **set** key [value] - sets value of the key (see the Params::setArg method).
+ *  * **loglevel** [0 - 3] - prints or sets verbose level of the QALogger.
+ *  * **flush** - flushes the logs.
+ *  * **metrics** - prints startup phases and statistics of the settings (if profiling of the settings is enabled).
+ *  * **sync** - invokes the ISettings::sync method.
+ *  * **reloadcache** - invokes the ISettings::forceReloadCache method.
+ *  * **reload** - invokes the Params::reload method.
+ *  * **locale** [name] - prints or sets locale of the application (see the Locales::setLocale method).
+ *  * **quit** - closes the connection.
+ *
+ * Example:
+ * @code{cpp}
+ *  QuasarAppUtils::ControlSocket::start("/run/user/1000/myapp.sock");
+ * @endcode
+ *
+ * @code{bash}
+ *  echo "loglevel 3" | socat - UNIX-CONNECT:/run/user/1000/myapp.sock
+ * @endcode
+ *
+ * @note The socket file is accessible only for the owner of the process (mode 0600).
+ * @note This class is supported only on unix platforms. On other platforms the start method return false.
+ */
+class QUASARAPPSHARED_EXPORT ControlSocket
+{
+public:
+    ControlSocket() = delete;
+
+    /**
+     * @brief start This method creates the socket and starts the thread of the endpoint.
+     * @param path This is path to the socket file. The stale socket file will be removed,
+     *  but if other process listens the @a path then this method fails.
+     * @return true if the endpoint started successful else false.
+     */
+    static bool start(const QString& path);
+
+    /**
+     * @brief stop This method stops the thread of the endpoint and removes the socket file.
+     */
+    static void stop();
+
+    /**
+     * @brief isActive This method return true if the endpoint is started.
+     * @return true if the endpoint is started else false.
+     */
+    static bool isActive();
+
+    /**
+     * @brief execute This method executes the one @a command of the protocol.
+     * @param command This is command line, for example "loglevel 3".
+     * @return response of the command, the last line is "OK" or "ERROR <message>".
+     */
+    static QString execute(const QString& command);
+};
+
+}
+
+#endif // CONTROLSOCKET_H
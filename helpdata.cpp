@@ -21,87 +21,142 @@ namespace Help {
 static int MAX_LENGTH = -1;
 static int SectionMargin = 2;
 
-#define EXPANDER(COUNT, ITEM) QString(COUNT, ITEM).toStdString()
-#define SPACES(X) EXPANDER(X, ' ')
-#define SECTION_MARGIN SPACES(SectionMargin)
-#define WIDTH ((MAX_LENGTH > 10)? MAX_LENGTH: width())
+// width of the help if the output is not a console.
+#define DEFAULT_WIDTH 80
 
+static inline void appendSpaces(QString& out, qsizetype count) {
+    if (count > 0) {
+        out.resize(out.size() + count, QChar(' '));
+    }
+}
 
 /*
- * @brief print This method prints the one line of the help.
+ * @brief render This method renders the one line of the help.
  * @param key This is Option name.
  * @param value This is Description of option.
  * @param keyLength  This is length of the current line.
+ * @param lineWidth This is width of the console window.
+ * @param out This is result buffer.
  * This is private method of the QuasarAppLibrary.
  */
-void print(const QString& key, const QString& value, int keyLength) {
+static void render(const QString& key, const QString& value, int keyLength, int lineWidth, QString& out) {
 
-    auto diffExpander = QString(keyLength - key.size(), ' ');
-    std::cout << SECTION_MARGIN << key.toStdString() << diffExpander.toStdString() << ":";
+    appendSpaces(out, SectionMargin);
+    out += key;
+    appendSpaces(out, keyLength - key.size());
+    out += ':';
 
-    QString expander(keyLength + SectionMargin, ' ');
-    auto words = value.split(" ");
+    const auto words = QStringView(value).split(u' ');
 
     int currentLength = std::max(keyLength, static_cast<int>(key.size()));
     for (const auto& word : words) {
-        if (currentLength + 2 + word.size() < WIDTH) {
-            std::cout << " " << word.toStdString();
-            currentLength += 2 + word.size();
-
-        } else {
-            std::cout << std::endl << expander.toStdString() << ":";
+        if (currentLength + 2 + word.size() >= lineWidth) {
+            out += '\n';
+            appendSpaces(out, keyLength + SectionMargin);
+            out += ':';
             currentLength = keyLength;
-
-            std::cout << " " << word.toStdString();
-            currentLength += 2 + word.size();
         }
+
+        out += ' ';
+        out += word;
+        currentLength += 2 + word.size();
     }
 }
 
-void print(const QuasarAppUtils::Help::Options &oprionsList) {
+static void render(const Options &oprionsList, int lineWidth, QString& out) {
     int maxLength = 0;
     for (auto line = oprionsList.begin(); line != oprionsList.end(); ++line) {
         if (line.key().size() > maxLength)
             maxLength = line.key().size();
     }
 
-    maxLength = std::min(WIDTH / 3, maxLength);
+    maxLength = std::min(lineWidth / 3, maxLength);
 
     for (auto line = oprionsList.begin(); line != oprionsList.end(); ++line) {
-        print(line.key(), line.value(), maxLength + SectionMargin);
-        std::cout << std::endl;
+        render(line.key(), line.value(), maxLength + SectionMargin, lineWidth, out);
+        out += '\n';
     }
 }
 
-void print(const Section &help) {
-    for (auto line = help.begin(); line != help.end(); ++line) {
-        QString expander(WIDTH, '-');
+QByteArray render(const Options &oprionsList, int lineWidth) {
+    if (lineWidth <= 10) {
+        lineWidth = Help::lineWidth();
+    }
 
-        std::cout << line.key().toStdString() << std::endl;
-        std::cout << expander.toStdString() << std::endl;
-        print(line.value());
-        std::cout << std::endl << expander.toStdString() << std::endl;
+    QString out;
+    render(oprionsList, lineWidth, out);
+    return out.toUtf8();
+}
+
+QByteArray render(const Section &help, int lineWidth) {
+    if (lineWidth <= 10) {
+        lineWidth = Help::lineWidth();
+    }
+
+    const QString expander(lineWidth, '-');
+
+    QString out;
+    for (auto line = help.begin(); line != help.end(); ++line) {
+        out += line.key();
+        out += '\n';
+        out += expander;
+        out += '\n';
+        render(line.value(), lineWidth, out);
+        out += '\n';
+        out += expander;
+        out += '\n';
     }
+
+    return out.toUtf8();
+}
+
+void write(const QByteArray &page) {
+    std::cout.write(page.constData(), page.size());
+    std::cout.flush();
+}
+
+void print(const QuasarAppUtils::Help::Options &oprionsList) {
+    write(render(oprionsList));
+}
+
+void print(const Section &help) {
+    write(render(help));
 }
 
 void setLineLength(int newLength) {
     MAX_LENGTH = newLength;
 }
 
-int width() {
+int lineWidth() {
+    return (MAX_LENGTH > 10)? MAX_LENGTH: width();
+}
+
+static int queryWidth() {
 
 #ifdef Q_OS_WIN32
     CONSOLE_SCREEN_BUFFER_INFO csbi;
 
-    GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi);
+    if (!GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi)) {
+        return DEFAULT_WIDTH;
+    }
+
     return csbi.srWindow.Right - csbi.srWindow.Left + 1;
 #else
-    struct winsize w;
-    ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
+    struct winsize w = {};
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &w) < 0 || w.ws_col <= 10) {
+        return DEFAULT_WIDTH;
+    }
+
     return w.ws_col;
 #endif
 }
 
+int width() {
+    // the console is queried only once.
+    static const int result = queryWidth();
+    return result;
+}
+
 
 }
 
@@ -8,6 +8,7 @@
 #ifndef HELPDATA_H
 #define HELPDATA_H
 
+#include <QByteArray>
 #include <QMap>
 #include "quasarapp_global.h"
 
@@ -53,9 +54,41 @@ typedef Section Charters;
 /**
  * @brief width This method return current width of the cosole window.
  * @return width in pxels of the cosole window.
+ * @note The console is queried on first call only, if the output is not a console then returns 80.
  */
 int width();
 
+/**
+ * @brief lineWidth This method return width of the help line. It is value of the setLineLength method or width of the console window.
+ * @return width of the help line.
+ * @note The console window is queried only once.
+ */
+int QUASARAPPSHARED_EXPORT lineWidth();
+
+/**
+ * @brief render This method renders a one options list into buffer.
+ * @param oprionsList This is options list.
+ * @param lineWidth This is width of the line. If this value is less than 10 then the Help::lineWidth will be used.
+ * @return utf8 text of the options list.
+ */
+QByteArray QUASARAPPSHARED_EXPORT render(const Options& oprionsList, int lineWidth = -1);
+
+/**
+ * @brief render This method renders all sections of the help into one buffer, so the rendered page can be cached and printed by one write.
+ * @param help This is sections list.
+ * @param lineWidth This is width of the line. If this value is less than 10 then the Help::lineWidth will be used.
+ * @return utf8 text of the help.
+ * @see Help::write
+ */
+QByteArray QUASARAPPSHARED_EXPORT render(const Section& help, int lineWidth = -1);
+
+/**
+ * @brief write This method writes the rendered @a page into the console by one call.
+ * @param page This is rendered help.
+ * @see Help::render
+ */
+void QUASARAPPSHARED_EXPORT write(const QByteArray& page);
+
 /**
  * @brief print This method print a one options list.
  * @param oprionsList This is options list.
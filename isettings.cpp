@@ -6,32 +6,233 @@
 */
 
 #include "isettings.h"
+#include "settingslistner.h"
 #include <QSettings>
 #include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QMetaMethod>
+#include <QThread>
+#include <algorithm>
 #include "qaglobalutils.h"
 
 namespace QuasarAppUtils {
 
+namespace {
+
+// listners that handle changes in the current thread right now, nullptr if the listner was removed by own handler.
+thread_local QList<SettingsListner*> deliveringListners;
+
+}
+
 ISettings::ISettings(SettingsSaveMode mode) {
     _mode = mode;
 }
 
 ISettings::~ISettings() {
+    stopWarmUp();
+
     if (_defaultConfig)
         delete _defaultConfig;
 }
 
 void ISettings::clearCache() {
+    QMutexLocker locker(cacheMutex());
     _cache.clear();
+    _cacheAccess.clear();
+    _dirtyKeys.clear();
+    _cacheBytes = 0;
+}
+
+void ISettings::setCacheLimit(qint64 bytes, qint64 largeValueThreshold) {
+    QMutexLocker locker(cacheMutex());
+
+    _cacheLimit = qMax(bytes, 0LL);
+    _largeValueThreshold = qMax(largeValueThreshold, 0LL);
+
+    // the size of the cache is not counted while limits are disabled, so recalculate it.
+    _cacheBytes = 0;
+    for (auto it = _cache.cbegin(); it != _cache.cend(); ++it) {
+        _cacheBytes += estimateSize(it.key(), it.value());
+    }
+
+    evictCache();
+}
+
+qint64 ISettings::cacheLimit() const {
+    return _cacheLimit;
+}
+
+qint64 ISettings::largeValueThreshold() const {
+    return _largeValueThreshold;
+}
+
+qint64 ISettings::estimateSize(const QString &key, const QVariant &value) {
+    qint64 size = sizeof(QVariant) + key.size() * sizeof(QChar);
+
+    switch (value.typeId()) {
+    case QMetaType::QString:
+        return size + value.toString().size() * sizeof(QChar);
+
+    case QMetaType::QByteArray:
+        return size + value.toByteArray().size();
+
+    case QMetaType::QStringList: {
+        const auto list = value.toStringList();
+        for (const auto& item: list) {
+            size += sizeof(QString) + item.size() * sizeof(QChar);
+        }
+        return size;
+    }
+
+    case QMetaType::QVariantList: {
+        const auto list = value.toList();
+        for (const auto& item: list) {
+            size += estimateSize({}, item);
+        }
+        return size;
+    }
+
+    case QMetaType::QVariantMap:
+    case QMetaType::QVariantHash: {
+        const auto map = value.toHash();
+        for (auto it = map.cbegin(); it != map.cend(); ++it) {
+            size += estimateSize(it.key(), it.value());
+        }
+        return size;
+    }
+
+    default:
+        return size;
+    }
+}
+
+void ISettings::storeInCache(const QString &key, const QVariant &value) {
+    if (!_cacheLimit && !_largeValueThreshold) {
+        _cache.insert(key, value);
+        return;
+    }
+
+    auto it = _cache.find(key);
+    if (it != _cache.end()) {
+        _cacheBytes -= estimateSize(key, *it);
+    }
+
+    const qint64 size = estimateSize(key, value);
+
+    // large values will be reloaded from the backend when needed, keep them only while they are not saved.
+    // keys of the default map are pinned.
+    if (_largeValueThreshold && size > _largeValueThreshold &&
+        !_dirtyKeys.contains(key) && !settingsMap().contains(key)) {
+        if (it != _cache.end()) {
+            _cache.erase(it);
+            _cacheAccess.remove(key);
+        }
+
+        return;
+    }
+
+    _cache.insert(key, value);
+    _cacheBytes += size;
+
+    if (_cacheLimit) {
+        _cacheAccess.insert(key, ++_accessTick);
+
+        if (_cacheBytes > _cacheLimit) {
+            evictCache();
+        }
+    }
+}
+
+void ISettings::evictCache() {
+    // the warm-up thread works with the cache, so do not evict until it finished.
+    if (_warmUpActive.loadAcquire()) {
+        return;
+    }
+
+    // keys of the default map are pinned, not saved values can't be evicted.
+    const auto &defaultConfig = settingsMap();
+
+    if (_largeValueThreshold) {
+        for (auto it = _cache.begin(); it != _cache.end();) {
+            const qint64 size = estimateSize(it.key(), it.value());
+            if (size > _largeValueThreshold &&
+                !_dirtyKeys.contains(it.key()) &&
+                !_batchChanges.contains(it.key()) &&
+                !defaultConfig.contains(it.key())) {
+                _cacheBytes -= size;
+                _cacheAccess.remove(it.key());
+                it = _cache.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    if (!_cacheLimit || _cacheBytes <= _cacheLimit) {
+        return;
+    }
+
+    QList<QPair<quint64, QString>> candidates;
+    for (auto it = _cache.cbegin(); it != _cache.cend(); ++it) {
+        if (defaultConfig.contains(it.key()) ||
+            _dirtyKeys.contains(it.key()) ||
+            _batchChanges.contains(it.key())) {
+            continue;
+        }
+
+        candidates.push_back({_cacheAccess.value(it.key()), it.key()});
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+
+    // evict a bit more than needed so that next inserts will not start eviction again.
+    const qint64 target = _cacheLimit * 3 / 4;
+    for (const auto &candidate: std::as_const(candidates)) {
+        if (_cacheBytes <= target)
+            break;
+
+        auto it = _cache.find(candidate.second);
+        _cacheBytes -= estimateSize(it.key(), it.value());
+        _cacheAccess.remove(it.key());
+        _cache.erase(it);
+    }
 }
 
 QHash<QString, QVariant> &ISettings::settingsMap() {
-    if (!_defaultConfig)
+    QMutexLocker locker(&_defaultsMutex);
+    if (!_defaultConfig) {
         _defaultConfig = new QHash<QString, QVariant>(defaultSettings());
 
+        for (size_t i = 0; i < _defaultsTable.count; ++i) {
+            const auto& item = _defaultsTable.items[i];
+            _defaultConfig->insert(QString::fromUtf8(item.key), item.value());
+        }
+    }
+
     return *_defaultConfig;
 }
 
+void ISettings::setDefaultsTable(const SettingsDefaultsView &table) {
+    QMutexLocker locker(&_defaultsMutex);
+    _defaultsTable = table;
+
+    // the settings map should be rebuilt with the new table.
+    delete _defaultConfig;
+    _defaultConfig = nullptr;
+}
+
+QVariant ISettings::defaultValue(const QString &key) {
+    if (auto item = _defaultsTable.find(key)) {
+        return item->value();
+    }
+
+    return settingsMap().value(key);
+}
+
+const SettingsDefaultsView &ISettings::defaultsTable() const {
+    return _defaultsTable;
+}
+
 SettingsSaveMode ISettings::getMode() const {
     return _mode;
 }
@@ -40,28 +241,361 @@ void ISettings::setMode(const SettingsSaveMode &mode) {
     _mode = mode;
 }
 
+void ISettings::beginBatch() {
+    _batchDepth++;
+}
+
+void ISettings::commit() {
+    debug_assert(_batchDepth > 0, "You try commit not started batch!");
+
+    if (_batchDepth <= 0 || --_batchDepth) {
+        return;
+    }
+
+    if (_batchChanges.isEmpty()) {
+        return;
+    }
+
+    QVariantHash changes;
+    changes.swap(_batchChanges);
+
+    if (_mode == SettingsSaveMode::Auto) {
+        for (auto it = changes.begin(); it != changes.end(); ++it) {
+            writeBackend(it.key(), it.value());
+        }
+
+        syncBackend();
+
+        // values of the batch are saved now, so they can leave the cache.
+        QMutexLocker locker(cacheMutex());
+        for (auto it = changes.cbegin(); it != changes.cend(); ++it) {
+            _dirtyKeys.remove(it.key());
+        }
+
+        evictCache();
+    }
+
+    for (auto it = changes.cbegin(); it != changes.cend(); ++it) {
+        notifyListners(it.key(), it.value());
+    }
+
+    emit valuesChanged(changes);
+}
+
+bool ISettings::isBatchActive() const {
+    return _batchDepth;
+}
+
 ISettings *ISettings::instance() {
     return Service<ISettings>::instance();
 }
 
-bool ISettings::initService(std::unique_ptr<ISettings> obj) {
-    return Service<ISettings>::initService(std::move(obj));
+bool ISettings::initService(std::unique_ptr<ISettings> obj, bool warmUp) {
+    auto settings = obj.get();
+    if (!Service<ISettings>::initService(std::move(obj))) {
+        return false;
+    }
+
+    if (warmUp && settings) {
+        settings->warmUp();
+    }
+
+    return true;
+}
+
+bool ISettings::initService(const std::function<std::unique_ptr<ISettings>()> &factory, bool warmUp) {
+    if (!Service<ISettings>::initService(factory)) {
+        return false;
+    }
+
+    if (warmUp) {
+        instance()->warmUp();
+    }
+
+    return true;
+}
+
+void ISettings::warmUp() {
+    if (_warmUpThread) {
+        return;
+    }
+
+    // build the default map on the current thread, the warm-up thread will only read it.
+    const auto &defaultConfig = settingsMap();
+    const QStringList keys = defaultConfig.keys() + hotKeys();
+
+    for (const auto &key: keys) {
+        if (!_cache.contains(key))
+            _warmUpPending.insert(key);
+    }
+
+    if (_warmUpPending.isEmpty()) {
+        return;
+    }
+
+    _warmUpStop.storeRelease(0);
+    _warmUpActive.storeRelease(1);
+    _warmUpThread = QThread::create([this, keys]() {
+        warmUpCache(keys);
+    });
+    _warmUpThread->start(QThread::LowPriority);
+}
+
+void ISettings::stopWarmUp() {
+    if (!_warmUpThread) {
+        return;
+    }
+
+    _warmUpStop.storeRelease(1);
+    _warmUpThread->wait();
+    delete _warmUpThread;
+    _warmUpThread = nullptr;
+}
+
+bool ISettings::isWarmUpActive() const {
+    return _warmUpActive.loadAcquire();
+}
+
+QStringList ISettings::hotKeys() const {
+    return {};
+}
+
+void ISettings::warmUpCache(const QStringList &keys) {
+    const auto &defaultConfig = *_defaultConfig;
+
+    for (const auto &key: keys) {
+        // the backend is destroying, so do not touch it anymore.
+        if (_warmUpStop.loadAcquire())
+            break;
+
+        {
+            QMutexLocker locker(&_cacheMutex);
+
+            // the key already loaded by a reader or duplicated in the list.
+            if (!_warmUpPending.remove(key) || _cache.contains(key))
+                continue;
+
+            _warmUpLoading = key;
+        }
+
+        const QVariant value = readBackend(key, defaultConfig.value(key));
+
+        QMutexLocker locker(&_cacheMutex);
+        if (!_cache.contains(key)) {
+            storeInCache(key, value);
+        }
+
+        _warmUpLoading.clear();
+        _warmUpCondition.wakeAll();
+    }
+
+    {
+        QMutexLocker locker(&_cacheMutex);
+        _warmUpPending.clear();
+    }
+
+    _warmUpActive.storeRelease(0);
+}
+
+QVariant ISettings::getValueOnWarmUp(const QString &key, const QVariant &def) {
+    QMutexLocker locker(&_cacheMutex);
+
+    // the warm-up thread reads this key right now, so just wait for it.
+    while (_warmUpLoading == key) {
+        _warmUpCondition.wait(&_cacheMutex);
+    }
+
+    auto it = _cache.constFind(key);
+    if (it != _cache.cend()) {
+        return *it;
+    }
+
+    // do not wait for the queue of the warm-up thread, read the key right now.
+    _warmUpPending.remove(key);
+    locker.unlock();
+
+    if (_profiling.loadRelaxed()) {
+        recordAccess(key, SettingsAccess::Miss);
+    }
+
+    QVariant defVal = def;
+    if (defVal.isNull()) {
+        defVal = _defaultConfig->value(key);
+    }
+
+    const QVariant value = readBackend(key, defVal);
+
+    locker.relock();
+    it = _cache.constFind(key);
+    if (it != _cache.cend()) {
+        return *it;
+    }
+
+    storeInCache(key, value);
+    return value;
+}
+
+QMutex *ISettings::cacheMutex() const {
+    return (_warmUpActive.loadAcquire())? &_cacheMutex: nullptr;
+}
+
+QVariant ISettings::readBackend(const QString &key, const QVariant &def) {
+    QMutexLocker locker((_warmUpActive.loadAcquire())? &_backendMutex: nullptr);
+
+    if (!_profiling.loadRelaxed()) {
+        return getValueImplementation(key, def);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    auto result = getValueImplementation(key, def);
+    recordAccess(key, SettingsAccess::Backend, timer.nsecsElapsed());
+
+    return result;
+}
+
+void ISettings::writeBackend(const QString &key, const QVariant &value) {
+    QMutexLocker locker((_warmUpActive.loadAcquire())? &_backendMutex: nullptr);
+
+    if (!_profiling.loadRelaxed()) {
+        setValueImplementation(key, value);
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    setValueImplementation(key, value);
+    recordAccess(key, SettingsAccess::Backend, timer.nsecsElapsed());
+}
+
+void ISettings::recordAccess(const QString &key, SettingsAccess access, qint64 backendTime) {
+    QMutexLocker locker(&_profileMutex);
+    auto &stats = _profile[key];
+
+    switch (access) {
+    case SettingsAccess::Read: stats.reads++; break;
+    case SettingsAccess::Write: stats.writes++; break;
+    case SettingsAccess::Miss: stats.misses++; break;
+    case SettingsAccess::Backend: stats.backendTime += backendTime; break;
+    }
+}
+
+void ISettings::setProfilingEnabled(bool enable) {
+    _profiling.storeRelaxed(enable);
+}
+
+bool ISettings::isProfilingEnabled() const {
+    return _profiling.loadRelaxed();
+}
+
+QHash<QString, SettingsKeyStats> ISettings::profile() const {
+    QMutexLocker locker(&_profileMutex);
+    return _profile;
+}
+
+void ISettings::resetProfile() {
+    QMutexLocker locker(&_profileMutex);
+    _profile.clear();
+}
+
+QString ISettings::profileReport(int topN, SettingsProfileOrder order) {
+    const auto stats = profile();
+
+    auto metric = [order](const SettingsKeyStats& item) -> qint64 {
+        switch (order) {
+        case SettingsProfileOrder::Reads: return item.reads;
+        case SettingsProfileOrder::Writes: return item.writes;
+        case SettingsProfileOrder::Misses: return item.misses;
+        case SettingsProfileOrder::BackendTime: return item.backendTime;
+        }
+
+        return 0;
+    };
+
+    QList<QString> keys = stats.keys();
+    std::sort(keys.begin(), keys.end(), [&stats, &metric](const QString& left, const QString& right) {
+        return metric(stats.value(left)) > metric(stats.value(right));
+    });
+
+    if (topN > 0 && keys.size() > topN) {
+        keys.resize(topN);
+    }
+
+    auto row = [](const QString& key, const QString& reads, const QString& writes,
+                  const QString& misses, const QString& backendTime) {
+        return key.leftJustified(40) + " " + reads.rightJustified(12) + " " +
+               writes.rightJustified(12) + " " + misses.rightJustified(12) + " " +
+               backendTime.rightJustified(14) + "\n";
+    };
+
+    QString report = row("Key", "Reads", "Writes", "Misses", "Backend(us)");
+    for (const auto& key : std::as_const(keys)) {
+        const auto item = stats.value(key);
+        report += row(key,
+                      QString::number(item.reads),
+                      QString::number(item.writes),
+                      QString::number(item.misses),
+                      QString::number(item.backendTime / 1000));
+    }
+
+    // keys that declared as default but never readed are candidates for removing.
+    QStringList unused;
+    const auto &defaultConfig = settingsMap();
+    for (auto it = defaultConfig.cbegin(); it != defaultConfig.cend(); ++it) {
+        if (!stats.value(it.key()).reads)
+            unused.push_back(it.key());
+    }
+
+    if (unused.size()) {
+        unused.sort();
+        report += "Never read default keys: " + unused.join(", ") + "\n";
+    }
+
+    return report;
+}
+
+void ISettings::syncBackend() {
+    QMutexLocker locker((_warmUpActive.loadAcquire())? &_backendMutex: nullptr);
+    syncImplementation();
 }
 
 QVariant ISettings::getValue(const QString &key, const QVariant &def) {
     debug_assert(key.size(), "You can't use the empty key value!");
 
-    if (!_cache.contains(key)) {
+    if (_profiling.loadRelaxed()) {
+        recordAccess(key, SettingsAccess::Read);
+    }
 
-        QVariant defVal = def;
-        if (defVal.isNull()) {
-            defVal = settingsMap().value(key);
+    if (_warmUpActive.loadAcquire()) {
+        return getValueOnWarmUp(key, def);
+    }
+
+    auto it = _cache.constFind(key);
+    if (it != _cache.cend()) {
+        if (_cacheLimit) {
+            _cacheAccess.insert(key, ++_accessTick);
         }
 
-        _cache[key] = getValueImplementation(key, defVal);
+        return *it;
+    }
+
+    if (_profiling.loadRelaxed()) {
+        recordAccess(key, SettingsAccess::Miss);
+    }
+
+    QVariant defVal = def;
+    if (defVal.isNull()) {
+        if (auto item = _defaultsTable.find(key)) {
+            defVal = item->value();
+        } else {
+            defVal = settingsMap().value(key);
+        }
     }
 
-    return _cache[key];
+    const QVariant value = readBackend(key, defVal);
+    storeInCache(key, value);
+
+    return value;
 }
 
 QString ISettings::getStrValue(const QString &key, const QString &def) {
@@ -87,42 +621,251 @@ bool ISettings::ignoreToRest(const QString &) const {
 }
 
 void ISettings::sync() {
-    for (auto it = _cache.begin(); it != _cache.end(); ++it) {
-        setValueImplementation(it.key(), it.value());
+    QHash<QString, QVariant> cache;
+    {
+        QMutexLocker locker(cacheMutex());
+        cache = _cache;
+    }
+
+    for (auto it = cache.begin(); it != cache.end(); ++it) {
+        writeBackend(it.key(), it.value());
     }
 
-    return syncImplementation();
+    syncBackend();
+
+    // all values are saved now, so large and cold values can leave the cache.
+    QMutexLocker locker(cacheMutex());
+    _dirtyKeys.clear();
+    evictCache();
 }
 
 void ISettings::forceReloadCache() {
     auto &defaultConfig = settingsMap();
 
-    for (auto it = defaultConfig.begin(); it != defaultConfig.end(); ++it) {
-        setValue(it.key(), getValueImplementation(it.key(), it.value()));
+    // not cached keys will be read from the backend on the first access, so reload only cached keys.
+    QHash<QString, QVariant> values;
+    const auto keys = cachedKeys();
+    for (const auto &key: keys) {
+        values.insert(key, readBackend(key, defaultConfig.value(key)));
     }
+
+    updateCache(values);
+}
+
+void ISettings::updateCache(const QHash<QString, QVariant> &values) {
+    QList<QPair<QString, QVariant>> changes;
+
+    QMutexLocker locker(cacheMutex());
+    for (auto it = values.cbegin(); it != values.cend(); ++it) {
+        auto cached = _cache.find(it.key());
+        if (cached == _cache.end())
+            continue;
+
+        // not saved values of the Manual mode and open batch are newer than the backend, so keep them.
+        if (_dirtyKeys.contains(it.key()) || _batchChanges.contains(it.key()))
+            continue;
+
+        // backends like ini files lose types of values, so bring new value to the type of the cached value before compare.
+        QVariant value = it.value();
+        if (cached->isValid() && value.isValid() &&
+            value.metaType() != cached->metaType() &&
+            value.canConvert(cached->metaType())) {
+            value.convert(cached->metaType());
+        }
+
+        if (*cached == value)
+            continue;
+
+        if (_cacheLimit || _largeValueThreshold) {
+            _cacheBytes += estimateSize(it.key(), value) - estimateSize(it.key(), *cached);
+        }
+
+        *cached = value;
+        changes.push_back({it.key(), value});
+    }
+    locker.unlock();
+
+    for (const auto &change: std::as_const(changes)) {
+        notifyValueChanged(change.first, change.second);
+    }
+}
+
+QStringList ISettings::cachedKeys() const {
+    QMutexLocker locker(cacheMutex());
+    return _cache.keys();
 }
 
 void ISettings::setValue(const QString &key, const QVariant &value) {
 
     debug_assert(key.size(), "You can't use the empty key value!");
 
-    if (_cache.contains(key) && _cache.value(key) == value) {
-        return;
+    if (_profiling.loadRelaxed()) {
+        recordAccess(key, SettingsAccess::Write);
     }
 
-    _cache[key] = value;
+    {
+        QMutexLocker locker(cacheMutex());
+        if (_cache.contains(key) && _cache.value(key) == value) {
+            return;
+        }
 
-    emit valueChanged(key, value);
-    emit valueStrChanged(key, value.toString());
+        if (_mode == SettingsSaveMode::Manual || _batchDepth) {
+            _dirtyKeys.insert(key);
+        }
 
+        storeInCache(key, value);
+    }
+
+    if (_batchDepth) {
+        _batchChanges[key] = value;
+        return;
+    }
+
+    // large values can leave the cache right after store, so the backend should be written before listners read the value.
     if (_mode == SettingsSaveMode::Auto) {
-        setValueImplementation(key, value);
+        writeBackend(key, value);
     }
 
+    notifyValueChanged(key, value);
 }
 
 void ISettings::setStrValue(const QString &key, const QString &value) {
     setValue(key, value);
 }
 
+void ISettings::addListner(SettingsListner *listner,
+                           const QStringList &keys,
+                           const QStringList &prefixes) {
+
+    QMutexLocker locker(&_listnersMutex);
+    _registeredListners.insert(listner, ++_lastListnerId);
+
+    if (keys.isEmpty() && prefixes.isEmpty()) {
+        _listners.push_back(listner);
+        return;
+    }
+
+    for (const auto& prefix: prefixes) {
+        _prefixListners[prefix].push_back(listner);
+        _prefixLengths[prefix.size()]++;
+    }
+
+    for (const auto& key: keys) {
+        _keyListners[key].push_back(listner);
+    }
+}
+
+void ISettings::removeListner(SettingsListner *listner,
+                              const QStringList &keys,
+                              const QStringList &prefixes) {
+
+    {
+        QMutexLocker locker(&_listnersMutex);
+        _registeredListners.remove(listner);
+
+        if (keys.isEmpty() && prefixes.isEmpty()) {
+            _listners.removeOne(listner);
+        }
+
+        removeListnerKeys(listner, keys, prefixes);
+    }
+
+    // the listner is removed by own handler, so the current thread will not touch it after the handler.
+    int own = 0;
+    for (auto& delivering: deliveringListners) {
+        if (delivering == listner) {
+            delivering = nullptr;
+            ++own;
+        }
+    }
+
+    // wait for deliveries of other threads, new deliveries can not start because the listner is not registered.
+    while (listner->_inFlight.loadAcquire() > own) {
+        QThread::yieldCurrentThread();
+    }
+}
+
+void ISettings::removeListnerKeys(SettingsListner *listner,
+                                  const QStringList &keys,
+                                  const QStringList &prefixes) {
+    for (const auto& prefix: prefixes) {
+        auto it = _prefixListners.find(prefix);
+        if (it == _prefixListners.end() || !it->removeOne(listner))
+            continue;
+
+        if (it->isEmpty())
+            _prefixListners.erase(it);
+
+        if (--_prefixLengths[prefix.size()] <= 0)
+            _prefixLengths.remove(prefix.size());
+    }
+
+    for (const auto& key: keys) {
+        auto it = _keyListners.find(key);
+        if (it == _keyListners.end())
+            continue;
+
+        it->removeOne(listner);
+        if (it->isEmpty())
+            _keyListners.erase(it);
+    }
+}
+
+void ISettings::notifyValueChanged(const QString &key, const QVariant &value) {
+    notifyListners(key, value);
+
+    emit valueChanged(key, value);
+
+    // toString conversion is not free, so do it only when someone waits for this signal.
+    static const QMetaMethod valueStrChangedSignal = QMetaMethod::fromSignal(&ISettings::valueStrChanged);
+    if (isSignalConnected(valueStrChangedSignal)) {
+        emit valueStrChanged(key, value.toString());
+    }
+}
+
+void ISettings::notifyListners(const QString &key, const QVariant &value) {
+
+    // the listners are collected under lock and invoked without it, so slow listners do not block other threads.
+    QList<QPair<SettingsListner*, quint64>> targets;
+    {
+        QMutexLocker locker(&_listnersMutex);
+
+        auto collect = [this, &targets](const QList<SettingsListner*>& listners) {
+            for (auto listner: listners) {
+                targets.push_back({listner, _registeredListners.value(listner)});
+            }
+        };
+
+        collect(_listners);
+        collect(_keyListners.value(key));
+
+        // check only lengths of the registered prefixes instead of the all prefixes.
+        for (auto it = _prefixLengths.cbegin(); it != _prefixLengths.cend() && it.key() <= key.size(); ++it) {
+            collect(_prefixListners.value(key.left(it.key())));
+        }
+    }
+
+    for (const auto &target: std::as_const(targets)) {
+        SettingsListner* listner = target.first;
+
+        {
+            // the listner can be removed by other thread or by handler of the previous listner.
+            QMutexLocker locker(&_listnersMutex);
+            auto registered = _registeredListners.constFind(listner);
+            if (registered == _registeredListners.cend() || *registered != target.second)
+                continue;
+
+            listner->_inFlight.ref();
+        }
+
+        deliveringListners.push_back(listner);
+        listner->notify(key, value);
+
+        // nullptr means that the listner was removed by own handler and can be destroyed already.
+        if (deliveringListners.takeLast()) {
+            listner->_inFlight.deref();
+        }
+    }
+}
+
 }
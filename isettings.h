@@ -10,13 +10,50 @@
 
 #include "qaservice.h"
 #include "quasarapp_global.h"
+#include "settingsdefaults.h"
+#include <QMutex>
 #include <QObject>
+#include <QSet>
 #include <QVariant>
+#include <QWaitCondition>
 
 class QSettings;
+class QThread;
 
 namespace QuasarAppUtils {
 
+class SettingsListner;
+
+/**
+ * @brief The SettingsKeyStats struct contains access statistics of the one settings key.
+ * @see ISettings::setProfilingEnabled
+ */
+struct SettingsKeyStats {
+    /// count of the ISettings::getValue calls.
+    quint64 reads = 0;
+    /// count of the ISettings::setValue calls.
+    quint64 writes = 0;
+    /// count of the reads that not found the key in the cache.
+    quint64 misses = 0;
+    /// total time in nanoseconds spent in the backend methods for this key.
+    qint64 backendTime = 0;
+};
+
+/**
+ * @brief The SettingsProfileOrder enum contains sort orders of the profile report.
+ * @see ISettings::profileReport
+ */
+enum class SettingsProfileOrder {
+    /// keys with bigger count of reads will be first.
+    Reads,
+    /// keys with bigger count of writes will be first.
+    Writes,
+    /// keys with bigger count of cache misses will be first.
+    Misses,
+    /// keys with bigger time spent in the backend will be first.
+    BackendTime
+};
+
 /**
  * @brief The SettingsSaveMode enum
  */
@@ -68,6 +105,16 @@ public:
      */
     Q_INVOKABLE QString getStrValue(const QString &key, const QString& def = {});
 
+    /**
+     * @brief defaultValue This method return default value of the @a key from the defaults table or the defaultSettings map.
+     * The backend and cache are not used, so this method can be invoked from any thread.
+     * @param key This is name of the required settings value.
+     * @return default value of the @a key or invalid value if the key has no default value.
+     * @see ISettings::defaultSettings
+     * @see ISettings::setDefaultsTable
+     */
+    QVariant defaultValue(const QString &key);
+
     /**
      * @brief resetToDefault This method reset all settings to default values.
      */
@@ -88,7 +135,7 @@ public:
 
     /**
      * @brief forceReloadCache This method force reload settings data from disk.
-     * @note Cache will be refreshed
+     * @note Cache will be refreshed. Only cached keys will be reloaded and only changed keys will be notified.
      */
     void forceReloadCache();
 
@@ -104,6 +151,30 @@ public:
      */
     void setMode(const SettingsSaveMode &mode);
 
+    /**
+     * @brief beginBatch This method starts a batch of changes.
+     * All changes made by the setValue method after this call will be stored in the cache only.
+     * The changes will be written to the backend and notified by the single valuesChanged signal when the commit method will be invoked.
+     * @note Batches can be nested, changes will be applied on the commit of the outermost batch.
+     * @see ISettings::commit
+     * @see SettingsBatch
+     */
+    void beginBatch();
+
+    /**
+     * @brief commit This method finishes the batch started by the beginBatch method.
+     * If this is the outermost batch then all changed values will be written to the backend (in the SettingsSaveMode::Auto mode)
+     *  with one sync and the valuesChanged signal will be emitted.
+     * @see ISettings::beginBatch
+     */
+    void commit();
+
+    /**
+     * @brief isBatchActive This method return true if the batch of changes is started.
+     * @return true if the batch of changes is started else false.
+     */
+    bool isBatchActive() const;
+
     /**
      * @brief instance This method returns pointer to current settings object.
      * @return pointer to current settings object.
@@ -114,13 +185,97 @@ public:
     /**
      * @brief initService This method initialize the global settings object.
      * @param obj This is prepared settings object. You should create a your object monyaly, and add to initialization
+     * @param warmUp This option starts loading of the default and hot keys into cache on the background thread. See the ISettings::warmUp method.
      * @code{cpp}
      *  bool result = initService(std::make_unique<MySettings>());
      * @endcode
      * @return true if initialization finished successful else false.
      * @see Service::initService
      */
-    static bool initService(std::unique_ptr<ISettings> obj);
+    static bool initService(std::unique_ptr<ISettings> obj, bool warmUp = false);
+
+    /**
+     * @brief initService This method initialize the global settings object created by the @a factory.
+     * The @a factory is invoked only if the settings object is not initialized, under the lock of the initialization.
+     * @param factory This is function that creates the settings object.
+     * @param warmUp This option starts loading of the default and hot keys into cache on the background thread. See the ISettings::warmUp method.
+     * @return true if the object of the @a factory was saved as a global settings object else false.
+     * @see Service::initService
+     */
+    static bool initService(const std::function<std::unique_ptr<ISettings>()>& factory, bool warmUp = false);
+
+    /**
+     * @brief warmUp This method starts loading of the all keys from the defaultSettings map and the hotKeys list into the cache on the background thread.
+     * The getValue method invoked while warm-up is active waits only for own key. If the key is not loaded yet then it will be read immediately.
+     * @note The backend methods will be invoked from two threads while warm-up is active, but never at the same time.
+     * @note do nothing if warm-up already started.
+     * @see ISettings::hotKeys
+     * @see ISettings::isWarmUpActive
+     */
+    void warmUp();
+
+    /**
+     * @brief isWarmUpActive This method return true if the warm-up thread still loads keys into cache.
+     * @return true if the warm-up is active else false.
+     */
+    bool isWarmUpActive() const;
+
+    /**
+     * @brief setProfilingEnabled This method enables or disables collecting of the access statistics for each key.
+     * When profiling is disabled the getValue and setValue methods check only one flag.
+     * @param enable This is new state of the profiling.
+     * @see ISettings::profileReport
+     */
+    void setProfilingEnabled(bool enable);
+
+    /**
+     * @brief isProfilingEnabled This method return true if the access statistics is collected.
+     * @return true if the profiling is enabled else false.
+     */
+    bool isProfilingEnabled() const;
+
+    /**
+     * @brief profile This method return collected access statistics of the all keys.
+     * @return map of the keys and them statistics.
+     */
+    QHash<QString, SettingsKeyStats> profile() const;
+
+    /**
+     * @brief resetProfile This method removes all collected access statistics.
+     */
+    void resetProfile();
+
+    /**
+     * @brief profileReport This method return human readable table with statistics of the most used keys.
+     * The report contains also list of the default keys that never been read.
+     * @param topN This is count of keys in the table. If this value less or equal 0 then all keys will be printed.
+     * @param order This is sort order of the keys.
+     * @return the report string.
+     */
+    QString profileReport(int topN = 20, SettingsProfileOrder order = SettingsProfileOrder::Reads);
+
+    /**
+     * @brief setCacheLimit This method sets memory budget of the settings cache.
+     * When the cache becomes bigger than @a bytes, least recently used values will be evicted from the cache and reloaded from the backend on next access.
+     * Keys of the defaultSettings map and not saved values are never evicted.
+     * @param bytes This is approximate maximum size of the cache in bytes. Set 0 to disable the limit.
+     * @param largeValueThreshold Values bigger than this size in bytes will not be kept in the cache after saving and will be read from the backend on each access. Set 0 to disable.
+     * @note Both limits are disabled by default.
+     * @see ISettings::cacheLimit
+     */
+    void setCacheLimit(qint64 bytes, qint64 largeValueThreshold = 0);
+
+    /**
+     * @brief cacheLimit This method return current memory budget of the settings cache.
+     * @return maximum size of the cache in bytes or 0 if the cache is not limited.
+     */
+    qint64 cacheLimit() const;
+
+    /**
+     * @brief largeValueThreshold This method return size of the values that not kept in the cache.
+     * @return size in bytes or 0 if all values are cached.
+     */
+    qint64 largeValueThreshold() const;
 
 public slots:
     /**
@@ -143,6 +298,7 @@ signals:
      * @brief valueChanged This signal when value of the @a key settings changed
      * @param key This is name of change setting.
      * @param value This is a new value of @a key.
+     * @note This signal will not be emitted for changes made in the batch. See the valuesChanged signal.
      */
     void valueChanged(QString key, QVariant value);
 
@@ -153,10 +309,25 @@ signals:
      */
     void valueStrChanged(QString key, QString value);
 
+    /**
+     * @brief valuesChanged This signal emitted once when the batch of changes has been commited.
+     * @param values This is map of the all changed settings and them new values.
+     * @see ISettings::beginBatch
+     * @see ISettings::commit
+     */
+    void valuesChanged(QVariantHash values);
+
 protected:
 
     explicit ISettings(SettingsSaveMode mode = SettingsSaveMode::Auto);
 
+    /**
+     * @brief stopWarmUp This method stops loading of the cache on the background thread and waits for the warm-up thread.
+     * @note The warm-up thread invokes the getValueImplementation method, so each backend must invoke this method at first in own destructor, before the backend data will be destroyed.
+     * @see ISettings::warmUp
+     */
+    void stopWarmUp();
+
     /**
      * @brief defaultSettings This method must be return default map of the settings and them values. If the default value argument in a getValue method will be skipped, then settings model try find a default value in this map.
      * @return The default settings map.
@@ -180,6 +351,13 @@ protected:
      */
     virtual QHash<QString, QVariant> defaultSettings() = 0;
 
+    /**
+     * @brief hotKeys This method should return list of the keys that not present in the defaultSettings map but should be loaded by the ISettings::warmUp method.
+     * @return list of the hot keys.
+     * The default implementation returns empty list.
+     */
+    virtual QStringList hotKeys() const;
+
     /**
      * @brief syncImplementation This method should save all configuration data to the hard drive;
      */
@@ -213,14 +391,135 @@ protected:
      */
     QHash<QString, QVariant>& settingsMap();
 
+    /**
+     * @brief setDefaultsTable This method sets compile-time table of the default settings.
+     * Default values of the table will be used before values of the defaultSettings method
+     *  and lookup of the table not requires any allocations.
+     * @param table This is view of the static constexpr table.
+     * @note Invoke this method in the constructor of your settings class, before warm-up.
+     * @see makeSettingsDefaults
+     * @see ISettings::defaultsTable
+     */
+    void setDefaultsTable(const SettingsDefaultsView& table);
+
+    /**
+     * @brief defaultsTable This method return compile-time table of the default settings.
+     * @return view of the table of the default settings.
+     * @see ISettings::setDefaultsTable
+     */
+    const SettingsDefaultsView& defaultsTable() const;
+
+    /**
+     * @brief updateCache This method applies the @a values that was read from the backend to the cache.
+     * Only keys that already cached and have different values will be changed and notified.
+     * Not saved keys (see the ISettings::sync and ISettings::commit methods) will not be changed.
+     * The backend will not be written.
+     * @param values This is map of the keys and them values on the backend.
+     */
+    void updateCache(const QHash<QString, QVariant>& values);
+
+    /**
+     * @brief cachedKeys This method return list of the keys that stored in the cache.
+     * @return list of the cached keys.
+     */
+    QStringList cachedKeys() const;
+
 private:
 
+    /**
+     * @brief notifyValueChanged This method notifies listners and emits signals about change of the @a key.
+     */
+    void notifyValueChanged(const QString& key, const QVariant& value);
+
+    void warmUpCache(const QStringList& keys);
+    QVariant getValueOnWarmUp(const QString &key, const QVariant& def);
+
+    /**
+     * @brief cacheMutex This method return mutex of the cache while warm-up is active else nullptr.
+     */
+    QMutex* cacheMutex() const;
+
+    /**
+     * @brief storeInCache This method inserts value into cache and evicts cold values if the cache is out of budget.
+     * @note invoke only under lock of the cacheMutex.
+     */
+    void storeInCache(const QString& key, const QVariant& value);
+    void evictCache();
+    static qint64 estimateSize(const QString& key, const QVariant& value);
+
+    enum class SettingsAccess {
+        Read,
+        Write,
+        Miss,
+        Backend
+    };
+
+    void recordAccess(const QString& key, SettingsAccess access, qint64 backendTime = 0);
+
+    // wrappers of the backend methods that serialize access to backend while warm-up is active.
+    QVariant readBackend(const QString &key, const QVariant& def);
+    void writeBackend(const QString &key, const QVariant& value);
+    void syncBackend();
+
     SettingsSaveMode _mode = SettingsSaveMode::Auto;
 
     QHash<QString, QVariant> _cache;
     QHash<QString, QVariant> *_defaultConfig = nullptr;
+    // guards creation of the default map, because the defaultValue method can be invoked from any thread.
+    QMutex _defaultsMutex;
+    SettingsDefaultsView _defaultsTable;
+
+    /**
+     * @brief addListner This method registers the @a listner for changes of the @a keys and keys that starts with the @a prefixes.
+     * If both lists are empty then the @a listner will receive changes of all keys.
+     */
+    void addListner(SettingsListner* listner, const QStringList& keys, const QStringList& prefixes);
+    void removeListner(SettingsListner* listner, const QStringList& keys, const QStringList& prefixes);
+    void removeListnerKeys(SettingsListner* listner, const QStringList& keys, const QStringList& prefixes);
+
+    /**
+     * @brief notifyListners This method invokes only listners that registered for the @a key.
+     * @note Listners are invoked without lock of the registry, and the removeListner method waits until other threads finish delivery to the removed listner.
+     */
+    void notifyListners(const QString& key, const QVariant& value);
+
+    int _batchDepth = 0;
+    QVariantHash _batchChanges;
+
+    // guards the listners registry.
+    QMutex _listnersMutex;
+    // registered listner -> id of the registration, so a new listner with address of the removed one is not notified by old snapshot.
+    QHash<SettingsListner*, quint64> _registeredListners;
+    quint64 _lastListnerId = 0;
+    QList<SettingsListner*> _listners;
+    QHash<QString, QList<SettingsListner*>> _keyListners;
+    QHash<QString, QList<SettingsListner*>> _prefixListners;
+    // length of the registered prefix -> count of prefixes with this length.
+    QMap<int, int> _prefixLengths;
+
+    QThread* _warmUpThread = nullptr;
+    QAtomicInt _warmUpActive = 0;
+    QAtomicInt _warmUpStop = 0;
+    mutable QMutex _cacheMutex;
+    QMutex _backendMutex;
+    QWaitCondition _warmUpCondition;
+    QSet<QString> _warmUpPending;
+    QString _warmUpLoading;
+
+    qint64 _cacheLimit = 0;
+    qint64 _largeValueThreshold = 0;
+    qint64 _cacheBytes = 0;
+    quint64 _accessTick = 0;
+    QHash<QString, quint64> _cacheAccess;
+    // values that are changed in cache but not saved into backend yet.
+    QSet<QString> _dirtyKeys;
+
+    QAtomicInt _profiling = 0;
+    mutable QMutex _profileMutex;
+    QHash<QString, SettingsKeyStats> _profile;
 
     friend class Service<ISettings>;
+    friend class SettingsListner;
 };
 
 
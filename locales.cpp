@@ -7,6 +7,7 @@
 
 
 #include "locales.h"
+#include "startupprofiler.h"
 
 #include <QCoreApplication>
 #include <QTranslator>
@@ -16,10 +17,17 @@
 #include <QLocale>
 #include <QMap>
 
+#include <atomic>
+
 using namespace QuasarAppUtils;
 
+namespace {
+std::atomic_bool localesInitialized = false;
+}
+
 bool QuasarAppUtils::Locales::findQmPrivate(const QString &prefix,
                                             QList<QTranslator*> &qmFiles) {
+    StartupProfiler::Scope scope("Locales::findQm", prefix);
 
     for (const auto &location: std::as_const(_locations)) {
 
@@ -29,6 +37,7 @@ bool QuasarAppUtils::Locales::findQmPrivate(const QString &prefix,
         for (const auto &file : availableFiles) {
             auto qmFile = new QTranslator();
 
+            StartupProfiler::Scope loadScope("Locales::loadQm", file.absoluteFilePath());
             if(!qmFile->load(file.absoluteFilePath())) {
                 qWarning() << "Failed to load translation file : "
                                   + file.absoluteFilePath();
@@ -165,6 +174,7 @@ bool Locales::init(const QLocale &locale, const QSet<QString> & location) {
 }
 
 bool Locales::initPrivate(const QLocale &locale, const QSet<QString> & locations) {
+    StartupProfiler::Scope scope("Locales::init");
 
 #if QT_VERSION <= QT_VERSION_CHECK(6, 0, 0)
     auto defaultTr = QLibraryInfo::location(QLibraryInfo::TranslationsPath);
@@ -175,11 +185,13 @@ bool Locales::initPrivate(const QLocale &locale, const QSet<QString> & locations
     if (!_locations.contains(defaultTr)) {
         _locations += defaultTr;
     }
+    localesInitialized = true;
 
     return setLocalePrivate(locale);
 }
 
 bool Locales::initPrivate(const QList<QLocale> &locales, const QSet<QString> &locations) {
+    StartupProfiler::Scope scope("Locales::init");
 #if QT_VERSION <= QT_VERSION_CHECK(6, 0, 0)
     auto defaultTr = QLibraryInfo::location(QLibraryInfo::TranslationsPath);
 #else
@@ -189,6 +201,7 @@ bool Locales::initPrivate(const QList<QLocale> &locales, const QSet<QString> &lo
     if (!_locations.contains(defaultTr)) {
         _locations += defaultTr;
     }
+    localesInitialized = true;
 
     for (const auto& locale: locales) {
         if (!setLocalePrivate(locale, false, false)) {
@@ -220,6 +233,10 @@ Locales *Locales::instance() {
     return instance;
 }
 
+bool Locales::isInit() {
+    return localesInitialized;
+}
+
 void Locales::removeOldTranslation(const QLocale &locale) {
     for (const auto & tr :std::as_const(_translations[locale])) {
         QCoreApplication::removeTranslator(tr);
@@ -78,6 +78,13 @@ public:
      */
     static Locales *instance();
 
+    /**
+     * @brief isInit This method checks if the Locales service was initialized by the init method.
+     * @return true if the init method was invoked at least once.
+     * @note This method do not create the Locales object, so it is safe to call it from any thread.
+     */
+    static bool isInit();
+
     /**
      * @brief currentLocate This method return current locate of applicatuon.
      * @return current or last sets locate of applciation.
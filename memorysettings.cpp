@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "memorysettings.h"
+#include <QRandomGenerator>
+#include <QThread>
+#include <algorithm>
+
+namespace QuasarAppUtils {
+
+MemorySettings::MemorySettings(const QHash<QString, QVariant> &values,
+                               const QHash<QString, QVariant> &defaults) {
+    _values = values;
+    _defaults = defaults;
+}
+
+MemorySettings::~MemorySettings() {
+    stopWarmUp();
+}
+
+void MemorySettings::setLatency(SettingsOperation operation, int latency, int jitter) {
+    _latency[static_cast<int>(operation)].storeRelaxed(std::max(latency, 0));
+    _jitter[static_cast<int>(operation)].storeRelaxed(std::max(jitter, 0));
+}
+
+int MemorySettings::latency(SettingsOperation operation) const {
+    return _latency[static_cast<int>(operation)].loadRelaxed();
+}
+
+int MemorySettings::jitter(SettingsOperation operation) const {
+    return _jitter[static_cast<int>(operation)].loadRelaxed();
+}
+
+QHash<QString, QVariant> MemorySettings::values() const {
+    QReadLocker locker(&_lock);
+    return _values;
+}
+
+void MemorySettings::syncImplementation() {
+    delay(SettingsOperation::Sync);
+}
+
+QVariant MemorySettings::getValueImplementation(const QString &key, const QVariant &def) {
+    delay(SettingsOperation::Get);
+
+    QReadLocker locker(&_lock);
+    return _values.value(key, def);
+}
+
+void MemorySettings::setValueImplementation(const QString key, const QVariant &value) {
+    delay(SettingsOperation::Set);
+
+    QWriteLocker locker(&_lock);
+    _values.insert(key, value);
+}
+
+QHash<QString, QVariant> MemorySettings::defaultSettings() {
+    return _defaults;
+}
+
+void MemorySettings::delay(SettingsOperation operation) const {
+    int time = latency(operation);
+    const int deviation = jitter(operation);
+
+    if (deviation) {
+        time += QRandomGenerator::global()->bounded(-deviation, deviation + 1);
+    }
+
+    if (time > 0) {
+        QThread::usleep(time);
+    }
+}
+
+}
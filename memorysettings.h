@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef MEMORYSETTINGS_H
+#define MEMORYSETTINGS_H
+
+#include "quasarapp_global.h"
+#include "isettings.h"
+#include <QReadWriteLock>
+
+namespace QuasarAppUtils {
+
+/**
+ * @brief The SettingsOperation enum contains operations of the settings backend.
+ */
+enum class SettingsOperation {
+    /// read of the value (see the ISettings::getValueImplementation method).
+    Get,
+    /// write of the value (see the ISettings::setValueImplementation method).
+    Set,
+    /// sync of the backend (see the ISettings::syncImplementation method).
+    Sync
+};
+
+/**
+ * @brief The MemorySettings class is settings backend that keeps all values in the memory.
+ * Each operation of the backend can be slowed down by the artificial latency with random jitter,
+ *  so this backend can be used for measure of behavior of the settings layer on the slow storage.
+ *
+ * Example of initialisation :
+ *
+ *  @code{cpp}
+ *     auto settings = std::make_unique<QuasarAppUtils::MemorySettings>();
+ *     // each read of the backend will take 200±50 microseconds.
+ *     settings->setLatency(QuasarAppUtils::SettingsOperation::Get, 200, 50);
+ *     QuasarAppUtils::ISettings::initService(std::move(settings));
+ *  @endcode
+ *
+ * @note The backend is thread-safe.
+ * @see SettingsBenchmark
+ */
+class QUASARAPPSHARED_EXPORT MemorySettings: public ISettings
+{
+    Q_OBJECT
+public:
+
+    /**
+     * @brief MemorySettings This constructor creates backend with initial @a values.
+     * @param values This is initial values of the backend.
+     * @param defaults This is default values of the settings.
+     */
+    explicit MemorySettings(const QHash<QString, QVariant>& values = {},
+                            const QHash<QString, QVariant>& defaults = {});
+    ~MemorySettings() override;
+
+    /**
+     * @brief setLatency This method sets artificial latency of the @a operation.
+     * @param operation This is operation of the backend.
+     * @param latency This is latency in microseconds.
+     * @param jitter This is maximum random deviation of the latency in microseconds.
+     */
+    void setLatency(SettingsOperation operation, int latency, int jitter = 0);
+
+    /**
+     * @brief latency This method return latency of the @a operation in microseconds.
+     * @see MemorySettings::setLatency
+     */
+    int latency(SettingsOperation operation) const;
+
+    /**
+     * @brief jitter This method return jitter of the latency of the @a operation in microseconds.
+     * @see MemorySettings::setLatency
+     */
+    int jitter(SettingsOperation operation) const;
+
+    /**
+     * @brief values This method return all values of the backend.
+     * @return all values of the backend.
+     */
+    QHash<QString, QVariant> values() const;
+
+protected:
+    void syncImplementation() override;
+    QVariant getValueImplementation(const QString &key, const QVariant &def) override;
+    void setValueImplementation(const QString key, const QVariant &value) override;
+    QHash<QString, QVariant> defaultSettings() override;
+
+private:
+    void delay(SettingsOperation operation) const;
+
+    mutable QReadWriteLock _lock;
+    QHash<QString, QVariant> _values;
+    QHash<QString, QVariant> _defaults;
+
+    QAtomicInt _latency[3];
+    QAtomicInt _jitter[3];
+};
+
+}
+#endif // MEMORYSETTINGS_H
@@ -25,6 +25,17 @@ OptionData::OptionData(const QStringList& name,
     _removed = removed;
 }
 
+OptionData::OptionData(const QStringList &names,
+                       OptionType type,
+                       const QString &arguments,
+                       const QString &description,
+                       const QString &example,
+                       const QString &depricatedMsg,
+                       bool removed):
+    OptionData(names, arguments, description, example, depricatedMsg, removed) {
+    _type = type;
+}
+
 const QStringList &OptionData::names() const {
     return _name;
 }
@@ -87,4 +98,118 @@ Help::Options OptionData::toHelp() const {
 bool OptionData::isValid() const {
     return names().size();
 }
+
+OptionType OptionData::type() const {
+    return _type;
+}
+
+bool OptionData::convert(const QString &value, QVariant *result) const {
+    bool ok = true;
+    QVariant converted;
+
+    switch (_type) {
+    case OptionType::String: converted = value; break;
+    case OptionType::Int: converted = value.toLongLong(&ok); break;
+    case OptionType::Bool: converted = toBool(value, &ok); break;
+    case OptionType::Duration: converted = toDuration(value, &ok); break;
+    case OptionType::Size: converted = toSize(value, &ok); break;
+    case OptionType::List: converted = toList(value); break;
+    }
+
+    if (ok && result) {
+        *result = converted;
+    }
+
+    return ok;
+}
+
+bool OptionData::toBool(const QString &value, bool *ok) {
+    if (ok)
+        *ok = true;
+
+    // the option without value is enabled.
+    const QString lower = value.trimmed().toLower();
+    if (lower.isEmpty() || lower == "true" || lower == "yes" || lower == "on" || lower == "1")
+        return true;
+
+    if (lower == "false" || lower == "no" || lower == "off" || lower == "0")
+        return false;
+
+    if (ok)
+        *ok = false;
+
+    return false;
+}
+
+qint64 OptionData::toDuration(const QString &value, bool *ok) {
+    static const QList<QPair<QString, qint64>> units = {
+        {"ms", 1},
+        {"s", 1000},
+        {"m", 60 * 1000},
+        {"h", 60 * 60 * 1000},
+        {"d", 24 * 60 * 60 * 1000}
+    };
+
+    const QString trimmed = value.trimmed();
+
+    qint64 multiplier = 1;
+    qsizetype numberSize = trimmed.size();
+    for (const auto &unit : units) {
+        if (trimmed.endsWith(unit.first, Qt::CaseInsensitive)) {
+            multiplier = unit.second;
+            numberSize = trimmed.size() - unit.first.size();
+            break;
+        }
+    }
+
+    bool converted = false;
+    const double number = QStringView(trimmed).left(numberSize).trimmed().toDouble(&converted);
+    converted = converted && number >= 0;
+
+    if (ok)
+        *ok = converted;
+
+    return (converted)? qint64(number * multiplier): 0;
+}
+
+qint64 OptionData::toSize(const QString &value, bool *ok) {
+    QString trimmed = value.trimmed().toUpper();
+
+    if (trimmed.endsWith("IB")) {
+        trimmed.chop(2);
+    } else if (trimmed.endsWith('B')) {
+        trimmed.chop(1);
+    }
+
+    qint64 multiplier = 1;
+    const QString suffixes = "KMGT";
+    if (trimmed.size() && suffixes.contains(trimmed.back())) {
+        for (int i = 0; i <= suffixes.indexOf(trimmed.back()); ++i) {
+            multiplier *= 1024;
+        }
+
+        trimmed.chop(1);
+    }
+
+    bool converted = false;
+    const double number = trimmed.trimmed().toDouble(&converted);
+    converted = converted && number >= 0;
+
+    if (ok)
+        *ok = converted;
+
+    return (converted)? qint64(number * multiplier): 0;
+}
+
+QStringList OptionData::toList(const QString &value) {
+    QStringList result;
+    const auto items = value.split(',', Qt::SkipEmptyParts);
+    for (const auto &item : items) {
+        const QString trimmed = item.trimmed();
+        if (trimmed.size())
+            result.push_back(trimmed);
+    }
+
+    return result;
+}
 }
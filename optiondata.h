@@ -11,9 +11,34 @@
 
 #include "quasarapp_global.h"
 #include "helpdata.h"
+#include <QVariant>
 
 namespace QuasarAppUtils{
 
+/**
+ * @brief The OptionType enum contains types of the values of the options.
+ * Typed values will be converted and validated once while parsing of the arguments.
+ * @see Params::getInt
+ * @see Params::getBool
+ * @see Params::getDuration
+ * @see Params::getSize
+ * @see Params::getList
+ */
+enum class OptionType {
+    /// value is not converted.
+    String,
+    /// integer value, for example: -threads 4
+    Int,
+    /// boolean value (true/false, yes/no, on/off, 1/0). An option without value is true.
+    Bool,
+    /// duration in milliseconds with optional suffix (ms, s, m, h, d), for example: -timeout 30s
+    Duration,
+    /// size in bytes with optional suffix (K, M, G, T with powers of 1024), for example: -cache 64M
+    Size,
+    /// comma separated list, for example: -plugins a,b,c
+    List
+};
+
 /**
  * @brief The OptionData class contains information about one option.
  */
@@ -37,6 +62,24 @@ public:
                const QString& depricatedMsg = "",
                bool removed = false);
 
+    /**
+     * @brief OptionData This constructor creates typed option.
+     * @param names This is names list of the option. It is a required argument and cannot be empty.
+     * @param type This is type of the option value. The value will be validated while parsing of the arguments.
+     * @param arguments This is input arguments of this option or help meesage about arguments.
+     * @param description This is description message of this option.
+     * @param example This is example of use string.
+     * @param depricatedMsg This is a message that will be printed as a warning if user will use this option.
+     * @param removed This option show depricatedMsg as a error and force the parseParams method return false.
+     */
+    OptionData(const QStringList& names,
+               OptionType type,
+               const QString& arguments = "",
+               const QString& description = "",
+               const QString& example = "",
+               const QString& depricatedMsg = "",
+               bool removed = false);
+
     /**
      * @brief name This is name of the option. It is a required argument and cannot be empty.
      * @return return name of this option.
@@ -96,6 +139,51 @@ public:
      */
     bool isDepricated() const;
 
+    /**
+     * @brief type This method return type of the option value.
+     * @return type of the option value.
+     */
+    OptionType type() const;
+
+    /**
+     * @brief convert This method converts the @a value to the type of this option.
+     * @param value This is raw value of the option.
+     * @param result This is converted value. Integers, durations and sizes are qint64, booleans are bool and lists are QStringList.
+     * @return true if the value converted successful else false.
+     */
+    bool convert(const QString& value, QVariant* result) const;
+
+    /**
+     * @brief toBool This method converts the @a value to boolean.
+     * @param value This is raw value.
+     * @param ok This is status of the conversion.
+     * @return converted value.
+     */
+    static bool toBool(const QString& value, bool* ok = nullptr);
+
+    /**
+     * @brief toDuration This method converts the @a value to duration in milliseconds.
+     * @param value This is raw value (for example 500ms, 30s, 5m, 2h, 1d). Value without suffix is milliseconds.
+     * @param ok This is status of the conversion.
+     * @return converted value in milliseconds.
+     */
+    static qint64 toDuration(const QString& value, bool* ok = nullptr);
+
+    /**
+     * @brief toSize This method converts the @a value to size in bytes.
+     * @param value This is raw value (for example 512, 4K, 64M, 1G, 2T). Suffixes are powers of 1024, the B and iB endings are allowed.
+     * @param ok This is status of the conversion.
+     * @return converted value in bytes.
+     */
+    static qint64 toSize(const QString& value, bool* ok = nullptr);
+
+    /**
+     * @brief toList This method splits the @a value by comma.
+     * @param value This is raw value.
+     * @return list of the trimmed not empty items.
+     */
+    static QStringList toList(const QString& value);
+
 protected:
     /**
      * @brief setNames This method sets new value of the option name.
@@ -142,6 +230,7 @@ private:
     QString _arguments;
     QString _depricatedMsg;
     bool _removed;
+    OptionType _type = OptionType::String;
 };
 
 /**
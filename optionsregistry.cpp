@@ -0,0 +1,22 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "optionsregistry.h"
+
+namespace QuasarAppUtils {
+
+OptionData OptionDefinition::toOptionData() const {
+    return OptionData({QString::fromUtf8(key)},
+                      type,
+                      QString::fromUtf8(arguments),
+                      QString::fromUtf8(description),
+                      QString::fromUtf8(example),
+                      QString::fromUtf8(depricatedMsg),
+                      removed);
+}
+
+}
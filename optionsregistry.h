@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef OPTIONSREGISTRY_H
+#define OPTIONSREGISTRY_H
+
+#include "quasarapp_global.h"
+#include "optiondata.h"
+#include "perfecthash.h"
+#include <type_traits>
+
+namespace QuasarAppUtils {
+
+/**
+ * @brief The OptionDefinition struct is one item of the compile-time options registry.
+ * Use the option function for create it.
+ * @see makeOptionsRegistry
+ */
+struct QUASARAPPSHARED_EXPORT OptionDefinition {
+    /// name of the option as it is written in the command line (for example "-verbose" or "help").
+    const char* key = nullptr;
+    /// crc32 hash of the name.
+    uint32_t hash = 0;
+    /// group of the option in the help.
+    const char* group = "";
+    /// type of the option value.
+    OptionType type = OptionType::String;
+    const char* arguments = "";
+    const char* description = "";
+    const char* example = "";
+    const char* depricatedMsg = "";
+    bool removed = false;
+
+    /**
+     * @brief toOptionData This method converts this definition to the OptionData object.
+     * @return option data of this definition.
+     */
+    OptionData toOptionData() const;
+};
+
+/**
+ * @brief option This function creates item of the options registry. Arguments are same as arguments of the OptionData constructor.
+ * @param group This is group of the option in the help.
+ * @param name This is name of the option as it is written in the command line.
+ */
+template <size_t N>
+constexpr OptionDefinition option(const char* group,
+                                  const char (&name)[N],
+                                  OptionType type = OptionType::String,
+                                  const char* arguments = "",
+                                  const char* description = "",
+                                  const char* example = "",
+                                  const char* depricatedMsg = "",
+                                  bool removed = false) {
+    return OptionDefinition{name, calculateCrc32(name, N - 1), group, type,
+                            arguments, description, example, depricatedMsg, removed};
+}
+
+/**
+ * @brief OptionsRegistryView is not template view of the OptionsRegistry.
+ * @see Params::parseParams
+ */
+using OptionsRegistryView = PerfectHashView<OptionDefinition>;
+
+/**
+ * @brief The OptionsRegistry class is compile-time table of the available options.
+ * Validation of the input arguments is one probe of the perfect hash without building of the OptionsDataList.
+ *
+ * **Example:**
+ *
+ * @code{cpp}
+ *  static constexpr auto options = QuasarAppUtils::makeOptionsRegistry(
+ *      QuasarAppUtils::option("Main", "-threads", QuasarAppUtils::OptionType::Int, "(count)", "Sets count of the threads"),
+ *      QuasarAppUtils::option("Main", "help", QuasarAppUtils::OptionType::Bool, "", "Shows help"));
+ *
+ *  static_assert(options.find(LITIRAL_CRC32("-threads")));
+ *
+ *  QuasarAppUtils::Params::parseParams(argc, argv, options.view());
+ *  auto threads = QuasarAppUtils::Params::getArg(PARAM_KEY("threads"));
+ * @endcode
+ *
+ * @note Names should be unique, else compilation fails.
+ */
+template <size_t N>
+using OptionsRegistry = PerfectHashTable<OptionDefinition, N>;
+
+/**
+ * @brief makeOptionsRegistry This function creates compile-time registry of the options.
+ * @param items This is list of options created by the option function.
+ * @return registry of the options.
+ */
+template <class... Items>
+constexpr OptionsRegistry<sizeof...(Items)> makeOptionsRegistry(const Items&... items) {
+    return OptionsRegistry<sizeof...(Items)>(std::array<OptionDefinition, sizeof...(Items)>{items...});
+}
+
+/**
+ * @brief The ParamKey struct is key of the parsed argument with hash calculated on compile time.
+ * Use the PARAM_KEY macro for create it.
+ * @see Params::getArg
+ */
+struct ParamKey {
+    /// name of the argument without the '-' prefix.
+    const char* name = nullptr;
+    /// crc32 hash of the name.
+    uint32_t hash = 0;
+};
+
+}
+
+/**
+ * @brief PARAM_KEY This macro creates ParamKey with hash calculated on compile time.
+ */
+#define PARAM_KEY(str) \
+    (QuasarAppUtils::ParamKey{str, std::integral_constant<uint32_t, LITIRAL_CRC32(str)>::value})
+
+#endif // OPTIONSREGISTRY_H
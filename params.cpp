@@ -12,7 +12,16 @@
 #include <QDateTime>
 #include <QCoreApplication>
 #include "qaglobalutils.h"
+#include "startupprofiler.h"
+#include "argumentstokenizer.h"
+#include "isettings.h"
+#include <QAnyStringView>
 #include <QtLogging>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QGlobalStatic>
+#include <memory>
+#include <vector>
 
 #ifdef Q_OS_DARWIN
 #include <mach-o/dyld.h>
@@ -25,15 +34,596 @@
 #endif
 
 using namespace QuasarAppUtils;
-QMap<QString, QString> Params::params = QMap<QString, QString>();
+
+// protection from the recursive including of the arguments files.
+#define MAX_ARGUMENTS_FILES_DEPTH 16
 QString Params::appPath = "";
 QString Params::appName = "";
 Help::Section Params::userHelp = {};
+OptionsDataList Params::userOptions = {};
+QByteArray Params::helpPage = {};
+int Params::helpPageWidth = 0;
 OptionsDataList Params::inputOptions = {};
+OptionsRegistryView Params::registry = {};
+SubcommandsView Params::subcommands = {};
+const SubcommandDefinition* Params::activeSubcommand = nullptr;
+std::vector<const OptionDefinition*> Params::inputDefinitions = {};
+
+namespace {
+
+/**
+ * @brief The RawParam struct is argument of the command line that is not converted to QString.
+ * Contains offsets of the key and value in the ParamsData::rawData buffer.
+ */
+struct RawParam {
+    qsizetype key = 0;
+    qsizetype keySize = 0;
+    qsizetype value = 0;
+    qsizetype valueSize = 0;
+    // crc32 of the key, calculated while publishing of the snapshot.
+    uint32_t hash = 0;
+};
+
+/**
+ * @brief The ParamsData struct is immutable snapshot of the arguments. It is never changed after publishing.
+ */
+struct ParamsData {
+    QHash<QString, QString> values;
+    // copy of the argv, the raw params are views of this buffer. Converted to QString only on read.
+    QByteArray rawData;
+    std::vector<RawParam> raw;
+    // values of the typed options converted while parsing.
+    QHash<QString, QVariant> typed;
+    // crc32 of the key -> key and value, used for lookup by compile-time keys.
+    QHash<uint32_t, QPair<QString, QString>> hashed;
+    // crc32 of the key -> index of the last raw param with this key, or -1 if hashes of the different keys are collided.
+    QHash<uint32_t, qsizetype> rawHashed;
+    // keys of the values that readed from the config file and not overridden by the command line.
+    QSet<QString> fromConfig;
+    // count of the different keys of the raw params, calculated while publishing of the snapshot.
+    qsizetype rawCount = 0;
+
+    void index() {
+        hashed.clear();
+        for (auto it = values.cbegin(); it != values.cend(); ++it) {
+            const uint32_t hash = calculateCrc32Utf8(it.key());
+            auto existing = hashed.find(hash);
+            if (existing != hashed.end()) {
+                // collision of the hashes, such keys will be found by string.
+                existing->first = QString();
+                continue;
+            }
+
+            hashed.insert(hash, {it.key(), it.value()});
+        }
+
+        rawHashed.clear();
+        for (qsizetype i = 0; i < static_cast<qsizetype>(raw.size()); ++i) {
+            auto& param = raw[i];
+            const QByteArrayView key = rawKey(param);
+            param.hash = calculateCrc32(key.data(), key.size());
+
+            auto existing = rawHashed.find(param.hash);
+            if (existing != rawHashed.end() && *existing >= 0 && rawKey(raw[*existing]) != key) {
+                // collision of the hashes, such keys will be found by the full scan.
+                *existing = -1;
+                continue;
+            }
+
+            if (existing != rawHashed.end() && *existing < 0) {
+                continue;
+            }
+
+            // the last argument wins, as in the values hash.
+            rawHashed.insert(param.hash, i);
+        }
+
+        rawCount = 0;
+        for (auto it = rawHashed.cbegin(); it != rawHashed.cend(); ++it) {
+            if (*it >= 0) {
+                ++rawCount;
+                continue;
+            }
+
+            // the collided hash, count different keys with this hash.
+            QSet<QByteArrayView> keys;
+            for (const auto& param : raw) {
+                if (param.hash == it.key()) {
+                    keys.insert(rawKey(param));
+                }
+            }
+
+            rawCount += keys.size();
+        }
+    }
+
+    QByteArrayView rawKey(const RawParam& param) const {
+        return QByteArrayView(rawData).sliced(param.key, param.keySize);
+    }
+
+    QByteArrayView rawValue(const RawParam& param) const {
+        return QByteArrayView(rawData).sliced(param.value, param.valueSize);
+    }
+
+    /**
+     * @brief findRaw This method finds the not converted argument by the crc32 @a hash of the @a key. The last argument wins, as in the values hash.
+     */
+    const RawParam* findRaw(uint32_t hash, QAnyStringView key) const {
+        auto index = rawHashed.constFind(hash);
+        if (index == rawHashed.cend()) {
+            return nullptr;
+        }
+
+        if (*index >= 0) {
+            const auto& param = raw[*index];
+            return (QAnyStringView::equal(key, QUtf8StringView(rawKey(param))))? &param: nullptr;
+        }
+
+        for (auto it = raw.crbegin(); it != raw.crend(); ++it) {
+            if (it->hash == hash && QAnyStringView::equal(key, QUtf8StringView(rawKey(*it)))) {
+                return &(*it);
+            }
+        }
+
+        return nullptr;
+    }
+
+    const RawParam* findRaw(const QString& key) const {
+        if (raw.empty()) {
+            return nullptr;
+        }
+
+        return findRaw(calculateCrc32Utf8(key), key);
+    }
+
+    /**
+     * @brief count This method return count of the arguments. Repeated raw arguments are counted once.
+     */
+    qsizetype count() const {
+        return values.size() + rawCount;
+    }
+
+    bool contains(const QString& key) const {
+        return values.contains(key) || findRaw(key);
+    }
+
+    bool find(const QString& key, QString* result) const {
+        auto value = values.constFind(key);
+        if (value != values.cend()) {
+            *result = *value;
+            return true;
+        }
+
+        if (auto param = findRaw(key)) {
+            *result = QString::fromUtf8(rawValue(*param));
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief all This method return all arguments converted to QString.
+     */
+    QHash<QString, QString> all() const {
+        if (raw.empty()) {
+            return values;
+        }
+
+        QHash<QString, QString> result;
+        for (const auto& param : raw) {
+            result.insert(QString::fromUtf8(rawKey(param)), QString::fromUtf8(rawValue(param)));
+        }
+        result.insert(values);
+
+        return result;
+    }
+
+    /**
+     * @brief materialize This method converts all raw arguments to the values hash. Used before changes of the snapshot.
+     */
+    void materialize() {
+        if (raw.empty()) {
+            return;
+        }
+
+        values = all();
+        raw.clear();
+        rawData.clear();
+    }
+};
+
+/**
+ * @brief The OptionsLookup struct finds options of the OptionsDataList by crc32 of the not converted name,
+ *  so names of the arguments are not converted to QString while parsing.
+ */
+struct OptionsLookup {
+    explicit OptionsLookup(const OptionsDataList& list):
+        options(list) {
+
+        for (auto it = list.cbegin(); it != list.cend(); ++it) {
+            const uint32_t hash = calculateCrc32Utf8(it.key());
+            auto existing = items.find(hash);
+            if (existing == items.end()) {
+                items.insert(hash, it);
+            } else if (*existing != list.cend() && existing->key() != it.key()) {
+                // collision of the hashes, such names will be found by string.
+                *existing = list.cend();
+            }
+        }
+    }
+
+    OptionsDataList::const_iterator find(QByteArrayView name) const {
+        auto item = items.constFind(calculateCrc32(name.data(), name.size()));
+        if (item == items.cend()) {
+            return options.cend();
+        }
+
+        if (*item == options.cend()) {
+            return options.constFind(QString::fromUtf8(name));
+        }
+
+        return (QAnyStringView::equal(QUtf8StringView(name), item->key()))? *item: options.cend();
+    }
+
+    const OptionsDataList& options;
+    // crc32 of the name -> first option with this name, or end if hashes of the different names are collided.
+    QHash<uint32_t, OptionsDataList::const_iterator> items;
+};
+
+constexpr auto builtinOptions = makeOptionsRegistry(
+    option("Base Options", "-verbose", OptionType::Int, "(level 1 - 3)", "Shows debug log"),
+    option("Base Options", "-fileLog", OptionType::String, "(path to file)",
+           "Sets path of log file. Default it is path to executable file with suffix '.log'"),
+    option("Base Options", "-config", OptionType::String, "(path to file)",
+           "Reads options from the file. Options of the command line override options of the file"),
+    option("Base Options", "-startupProfile", OptionType::String, "(path to file)",
+           "Prints durations of the startup phases on exit and saves them into the file in the chrome trace format"));
+
+/**
+ * @brief The ResolvedParam struct is value of the parameter merged from all sources.
+ */
+struct ResolvedParam {
+    QString value;
+    ParamsSource source = ParamsSource::None;
+};
+
+/**
+ * @brief The LayersCache struct contains values of the parameters that already resolved by the Params::value method.
+ * Sources are merged only for the requested keys, so the environment and settings are not enumerated.
+ */
+struct LayersCache {
+    QReadWriteLock lock;
+    QHash<QString, ResolvedParam> values;
+    QString environmentPrefix = "QA_";
+    // incremented on each invalidation, so results of the resolving started before the invalidation will not be cached.
+    quint64 generation = 0;
+};
+
+Q_GLOBAL_STATIC(LayersCache, layersCache)
+
+void invalidateLayersCache() {
+    if (auto cache = layersCache()) {
+        QWriteLocker locker(&cache->lock);
+        cache->values.clear();
+        cache->generation++;
+    }
+}
+
+// the empty pointer is constant initialized, so arguments can be read while static initialization.
+// access only by the std::atomic_load and std::atomic_store functions.
+std::shared_ptr<const ParamsData> _currentParams;
+
+/**
+ * @brief The ParamsReader class holds reference to the current snapshot.
+ * Each snapshot has own reference counter, so replaced snapshot will be destroyed when the last reader of it finished.
+ */
+class ParamsReader {
+public:
+    ParamsReader():
+        _data(std::atomic_load(&_currentParams)) {
+    }
+
+    const ParamsData* data() const {
+        return _data.get();
+    }
+
+private:
+    std::shared_ptr<const ParamsData> _data;
+};
+
+QMutex& writeMutex() {
+    static QMutex mutex;
+    return mutex;
+}
+
+/**
+ * @brief publishLocked This function replaces the current snapshot. Invoke only under lock of the writeMutex.
+ */
+void publishLocked(const ParamsData &data) {
+    auto fresh = std::make_shared<ParamsData>(data);
+    fresh->index();
+
+    invalidateLayersCache();
+
+    // the old snapshot will be destroyed by the last reader of it.
+    std::atomic_store(&_currentParams, std::shared_ptr<const ParamsData>(std::move(fresh)));
+}
+
+/**
+ * @brief currentLocked This function return values of the current snapshot converted to QString. Invoke only under lock of the writeMutex.
+ */
+ParamsData currentLocked() {
+    auto data = std::atomic_load(&_currentParams);
+    ParamsData result = (data)? *data: ParamsData{};
+    result.materialize();
+    return result;
+}
+
+/**
+ * @brief environmentName This function converts the @a key to name of the environment variable.
+ * For example the log-dir key with QA_ prefix will be converted to QA_LOG_DIR.
+ */
+QString environmentName(const QString& prefix, const QString& key) {
+    QString result = prefix;
+    result.reserve(prefix.size() + key.size());
+    for (const QChar symbol : key) {
+        result.push_back((symbol.isLetterOrNumber())? symbol.toUpper(): QChar('_'));
+    }
+
+    return result;
+}
+
+/**
+ * @brief resolveParam This function merges sources of the @a key in the next order:
+ *  command line arguments, environment variables, config file, settings.
+ *  The result is cached until the arguments or layers will be changed.
+ */
+ResolvedParam resolveParam(const QString& key) {
+    auto cache = layersCache();
+
+    quint64 generation = 0;
+    QString prefix;
+    if (cache) {
+        QReadLocker locker(&cache->lock);
+        auto cached = cache->values.constFind(key);
+        if (cached != cache->values.cend()) {
+            return *cached;
+        }
+
+        generation = cache->generation;
+        prefix = cache->environmentPrefix;
+    }
+
+    ResolvedParam result;
+
+    {
+        ParamsReader reader;
+        auto data = reader.data();
+        if (data && data->find(key, &result.value)) {
+            result.source = (data->fromConfig.contains(key))? ParamsSource::ConfigFile:
+                                                              ParamsSource::Arguments;
+        }
+    }
+
+    if (result.source != ParamsSource::Arguments && prefix.size()) {
+        const QString name = environmentName(prefix, key);
+        if (qEnvironmentVariableIsSet(name.toLatin1().constData())) {
+            result = {qEnvironmentVariable(name.toLatin1().constData()), ParamsSource::Environment};
+        }
+    }
+
+    // only defaults of the settings are used, because the cache of the settings is not thread-safe.
+    if (result.source == ParamsSource::None) {
+        if (auto settings = ISettings::instance()) {
+            const QVariant value = settings->defaultValue(key);
+            if (value.isValid()) {
+                result = {value.toString(), ParamsSource::Settings};
+            }
+        }
+    }
+
+    if (cache) {
+        QWriteLocker locker(&cache->lock);
+        if (cache->generation == generation) {
+            cache->values.insert(key, result);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief The ReloadSource struct contains arguments of the last successful parsing, used by the Params::reload method.
+ * Arguments of the main function are kept as one buffer with sizes of the arguments, so they are not converted while parsing.
+ */
+struct ReloadSource {
+    QMutex lock;
+    QStringList arguments;
+    QByteArray rawData;
+    std::vector<qsizetype> rawSizes;
+    OptionsDataList availableOptions;
+    OptionsRegistryView registry;
+    bool valid = false;
+};
+
+Q_GLOBAL_STATIC(ReloadSource, reloadSource)
+
+void rememberArguments(const QStringList& arguments,
+                       const QByteArray& rawData,
+                       const std::vector<qsizetype>& rawSizes,
+                       const OptionsDataList& availableOptions,
+                       const OptionsRegistryView& registry) {
+    if (auto source = reloadSource()) {
+        QMutexLocker locker(&source->lock);
+        source->arguments = arguments;
+        source->rawData = rawData;
+        source->rawSizes = rawSizes;
+        source->availableOptions = availableOptions;
+        source->registry = registry;
+        source->valid = true;
+    }
+}
+
+bool restoreArguments(QStringList* arguments, OptionsDataList* availableOptions, OptionsRegistryView* registry) {
+    auto source = reloadSource();
+    if (!source)
+        return false;
+
+    QMutexLocker locker(&source->lock);
+    if (!source->valid)
+        return false;
 
+    *arguments = source->arguments;
+    qsizetype begin = 0;
+    for (const auto size : source->rawSizes) {
+        arguments->push_back(QString::fromUtf8(QByteArrayView(source->rawData).sliced(begin, size)));
+        begin += size;
+    }
+
+    *availableOptions = source->availableOptions;
+    *registry = source->registry;
+    return true;
+}
+
+/**
+ * @brief resolvedLayers This function return values of the keys that already resolved by the Params::value method.
+ */
+QHash<QString, QString> resolvedLayers() {
+    QHash<QString, QString> result;
+    if (auto cache = layersCache()) {
+        QReadLocker locker(&cache->lock);
+        for (auto it = cache->values.cbegin(); it != cache->values.cend(); ++it) {
+            result.insert(it.key(), it->value);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief The Subscribers struct contains listeners of the changes of the arguments.
+ */
+struct Subscribers {
+    QMutex lock;
+    QMap<int, Params::ParamsListener> listeners;
+    int lastId = 0;
+};
+
+Q_GLOBAL_STATIC(Subscribers, subscribers)
+
+void notifySubscribers(const QSet<QString>& changed) {
+    QList<Params::ParamsListener> listeners;
+    if (auto list = subscribers()) {
+        QMutexLocker locker(&list->lock);
+        listeners = list->listeners.values();
+    }
+
+    // listeners are invoked without lock, so they can unsubscribe or read arguments.
+    for (const auto& listener : std::as_const(listeners)) {
+        listener(changed);
+    }
+}
+
+/**
+ * @brief typedArg This function return converted value of the @a key.
+ * Values of the typed options are taken from the snapshot, other values will be converted by the @a convert function.
+ */
+template <class Type, class Convert>
+Type typedArg(const QString& key, const Type& def, Convert convert) {
+    ParamsReader reader;
+    auto data = reader.data();
+    if (!data)
+        return def;
+
+    auto typed = data->typed.constFind(key);
+    if (typed != data->typed.cend()) {
+        return typed->value<Type>();
+    }
+
+    QString raw;
+    if (!data->find(key, &raw))
+        return def;
+
+    bool ok = false;
+    const Type result = convert(raw, &ok);
+    return (ok)? result: def;
+}
+
+}
+
+void Params::publish(const QHash<QString, QString> &values,
+                     const QHash<QString, QVariant> &typed,
+                     const QSet<QString> &fromConfig) {
+    QMutexLocker locker(&writeMutex());
+    ParamsData data;
+    data.values = values;
+    data.typed = typed;
+    data.fromConfig = fromConfig;
+    publishLocked(data);
+}
+
+QString Params::value(const QString &key, const QString &def) {
+    const auto param = resolveParam(key);
+    return (param.source == ParamsSource::None)? def: param.value;
+}
+
+bool Params::hasValue(const QString &key) {
+    return resolveParam(key).source != ParamsSource::None;
+}
+
+ParamsSource Params::sourceOf(const QString &key) {
+    return resolveParam(key).source;
+}
+
+void Params::setEnvironmentPrefix(const QString &prefix) {
+    if (auto cache = layersCache()) {
+        QWriteLocker locker(&cache->lock);
+        cache->environmentPrefix = prefix;
+        cache->values.clear();
+        cache->generation++;
+    }
+}
+
+QString Params::environmentPrefix() {
+    if (auto cache = layersCache()) {
+        QReadLocker locker(&cache->lock);
+        return cache->environmentPrefix;
+    }
+
+    return {};
+}
+
+void Params::invalidateLayers() {
+    invalidateLayersCache();
+}
+
+QHash<QString, QString> Params::snapshot() {
+    ParamsReader reader;
+    auto data = reader.data();
+    return (data)? data->all(): QHash<QString, QString>{};
+}
 
 bool Params::isEndable(const QString& key) {
-    return params.contains(key);
+    ParamsReader reader;
+    auto data = reader.data();
+    return data && data->contains(key);
+}
+
+bool Params::isEndable(const ParamKey &key) {
+    ParamsReader reader;
+    auto data = reader.data();
+    if (!data)
+        return false;
+
+    auto it = data->hashed.constFind(key.hash);
+    if (it == data->hashed.cend())
+        return data->findRaw(key.hash, QUtf8StringView(key.name));
+
+    if (QAnyStringView::equal(it->first, QUtf8StringView(key.name)))
+        return true;
+
+    return data->contains(QString::fromUtf8(key.name));
 }
 
 void Params::log(const QString &log, VerboseLvl vLvl) {
@@ -69,7 +659,8 @@ void Params::log(const QString &log, VerboseLvl vLvl) {
 
 
 VerboseLvl Params::getVerboseLvl() {
-    return static_cast<VerboseLvl>(getArg("verbose", DEFAULT_VERBOSE_LVL).toInt());
+    static const int defaultLvl = QString(DEFAULT_VERBOSE_LVL).toInt();
+    return static_cast<VerboseLvl>(getInt("verbose", defaultLvl));
 }
 
 bool Params::isDebug() {
@@ -85,12 +676,21 @@ bool Params::isDebugBuild() {
 }
 
 void Params::showHelp() {
+    materializeInputOptions();
 
     if (inputOptions.size() > 1) {
         showHelpForInputOptions();
-    } else {
-        Help::print(userHelp);
+        return;
+    }
+
+    // the page is rendered once for each width of the console.
+    const int width = Help::lineWidth();
+    if (helpPage.isEmpty() || helpPageWidth != width) {
+        helpPage = Help::render(getHelp(), width);
+        helpPageWidth = width;
     }
+
+    Help::write(helpPage);
 }
 
 void Params::showHelpForInputOptions() {
@@ -98,6 +698,7 @@ void Params::showHelpForInputOptions() {
 }
 
 Help::Section Params::getHelpOfInputOptions() {
+    materializeInputOptions();
 
     if (inputOptions.size() <= 1 ) {
         return {};
@@ -112,15 +713,58 @@ Help::Section Params::getHelpOfInputOptions() {
 }
 
 const Help::Section &Params::getHelp() {
+    // help is built only when it is required.
+    if (userHelp.isEmpty()) {
+        if (registry.count) {
+            OptionsDataList options;
+            for (size_t i = 0; i < registry.count; ++i) {
+                options.insert(registry.items[i].group, registry.items[i].toOptionData());
+            }
+
+            // the builtin registry is used without subcommand, so its options are already in the list.
+            if (registry.items != builtinOptions.view().items) {
+                options.unite(availableArguments());
+            }
+
+            parseAvailableOptions(options, nullptr, &userHelp);
+        } else if (userOptions.size()) {
+            parseAvailableOptions(userOptions, nullptr, &userHelp);
+        }
+
+        // the list of the subcommands is shown only if a subcommand is not selected.
+        if (subcommands.count && !activeSubcommand) {
+            Help::Options commands;
+            for (size_t i = 0; i < subcommands.count; ++i) {
+                commands.unite(subcommands.items[i].toHelp());
+            }
+
+            userHelp.insert("Commands", commands);
+        }
+    }
+
     return userHelp;
 }
 
-const QMap<QString, QString>& Params::getUserParamsMap() {
-    return params;
+void Params::resetHelp(const OptionsDataList &options) {
+    userOptions = options;
+    userHelp.clear();
+    helpPage.clear();
+    helpPageWidth = 0;
+}
+
+QMap<QString, QString> Params::getUserParamsMap() {
+    const auto values = snapshot();
+
+    QMap<QString, QString> result;
+    for (auto it = values.cbegin(); it != values.cend(); ++it) {
+        result.insert(it.key(), it.value());
+    }
+
+    return result;
 }
 
 void Params::clearParsedData() {
-    params.clear();
+    publish({});
     appPath = "";
     appName = "";
 }
@@ -134,70 +778,204 @@ QString Params::getCurrentExecutableDir() {
 }
 
 OptionsDataList Params::availableArguments() {
-    return OptionsDataList{
-        {
-            "Base Options",
-            OptionData{
-                {"-verbose"}, "(level 1 - 3)", "Shows debug log"
-            }
+    OptionsDataList result;
 
-        },
-        {
-            "Base Options",
-            OptionData{
-                {"-fileLog"}, "(path to file)", "Sets path of log file. Default it is path to executable file with suffix '.log'"
-            }
-        }
-    };
+    const auto view = builtinOptions.view();
+    for (size_t i = 0; i < view.count; ++i) {
+        result.insert(view.items[i].group, view.items[i].toOptionData());
+    }
+
+    return result;
+}
+
+OptionData Params::findOption(const QString &name,
+                               const OptionsDataList &availableOptions,
+                               const OptionsRegistryView &options) {
+    if (!options.count) {
+        return availableOptions.value(name, {{}});
+    }
+
+    auto definition = options.find(name);
+    if (!definition) {
+        definition = builtinOptions.view().find(name);
+    }
+
+    return (definition)? definition->toOptionData(): OptionData{{}};
+}
+
+qint64 Params::getInt(const QString &key, qint64 def) {
+    return typedArg<qint64>(key, def, [](const QString& value, bool* ok) {
+        return value.toLongLong(ok);
+    });
+}
+
+bool Params::getBool(const QString &key, bool def) {
+    return typedArg<bool>(key, def, [](const QString& value, bool* ok) {
+        return OptionData::toBool(value, ok);
+    });
+}
+
+std::chrono::milliseconds Params::getDuration(const QString &key, std::chrono::milliseconds def) {
+    return std::chrono::milliseconds(typedArg<qint64>(key, def.count(), [](const QString& value, bool* ok) {
+        return OptionData::toDuration(value, ok);
+    }));
+}
+
+qint64 Params::getSize(const QString &key, qint64 def) {
+    return typedArg<qint64>(key, def, [](const QString& value, bool* ok) {
+        return OptionData::toSize(value, ok);
+    });
+}
+
+QStringList Params::getList(const QString &key, const QStringList &def) {
+    return typedArg<QStringList>(key, def, [](const QString& value, bool* ok) {
+        *ok = true;
+        return OptionData::toList(value);
+    });
 }
 
 int Params::size() {
-    return params.size();
+    ParamsReader reader;
+    auto data = reader.data();
+    return (data)? data->count(): 0;
 }
 
 bool Params::optionsForEach(const QStringList &paramsArray,
-                            const OptionsDataList& availableOptions) {
+                            const OptionsDataList& availableOptions,
+                            const OptionsRegistryView& options,
+                            QHash<QString, QString> &values,
+                            QHash<QString, QVariant> &typed,
+                            OptionsDataList &usedOptions) {
 
     for (int i = 0 ; i < paramsArray.size(); ++i) {
 
-        QStringList virtualOptionsList = paramsArray[i].split('=');
+        const QString& token = paramsArray[i];
+        if (token.isEmpty()) {
+            continue;
+        }
 
-        if (virtualOptionsList.size() > 1) {
-            return optionsForEach(virtualOptionsList, availableOptions);
+        const bool withArgument = token[0] == '-';
+        bool hasArgument = false;
+
+        // flags have empty value, and missing argument has null value, so it will not be converted.
+        QString name = token;
+        QString value;
+
+        const qsizetype separator = token.indexOf('=');
+        if (separator > 0) {
+            // the key=value form.
+            name = token.left(separator);
+            value = token.mid(separator + 1);
+            hasArgument = true;
+        } else if (withArgument) {
+            hasArgument = i < (paramsArray.size() - 1) &&
+                          paramsArray[i + 1].size() &&
+                          paramsArray[i + 1][0] != '-';
+            if (hasArgument) {
+                value = paramsArray[++i];
+            }
+        } else {
+            value = "";
         }
 
-        auto optionData = availableOptions.value(paramsArray[i], {{}});
-        if (!checkOption(optionData, paramsArray[i])) {
+        auto optionData = findOption(name, availableOptions, options);
+        QVariant converted;
+        if (!checkOption(optionData, name, value, &converted)) {
             return false;
         }
 
-        inputOptions.insert(paramsArray[i], optionData);
+        if (!usedOptions.contains(name)) {
+            usedOptions.insert(name, optionData);
+        }
 
-        if (paramsArray[i][0] == '-') {
+        if (withArgument && !hasArgument) {
+            qCritical() << "Missing argument for " + name;
+            return false;
+        }
 
-            if (i < (paramsArray.size() - 1) && paramsArray[i + 1][0] != '-') {
-                params[paramsArray[i].mid(1)] = paramsArray[i + 1];
-                i++;
-            } else {
-                qCritical() << "Missing argument for " + paramsArray[i];
-                return false;
-            }
-        } else {
-            params[paramsArray[i]] = "";
+        const QString key = (withArgument)? name.mid(1): name;
+        values[key] = value;
+        if (converted.isValid()) {
+            typed[key] = converted;
         }
     }
 
     return true;
 }
 
-bool Params::parseParams(const int argc, const char *argv[], const OptionsDataList& options) {
+bool Params::expandArguments(const QStringList &paramsArray, QStringList *result, int depth) {
+    for (const auto& token : paramsArray) {
+        if (token.size() < 2 || token[0] != '@') {
+            result->push_back(token);
+            continue;
+        }
 
-    QStringList params;
-    for (int i = 1; i < argc; i++) {
-        params.push_back(argv[i]);
+        if (depth >= MAX_ARGUMENTS_FILES_DEPTH) {
+            qCritical() << "Too deep nesting of the arguments files:" << token;
+            return false;
+        }
+
+        QStringList fileArguments;
+        if (!readArgumentsFile(token.mid(1), &fileArguments) ||
+            !expandArguments(fileArguments, result, depth + 1)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Params::readArgumentsFile(const QString &path, QStringList *result) {
+    ArgumentsTokenizer tokenizer;
+    if (!tokenizer.open(path)) {
+        qCritical() << "Failed to read the arguments file:" << path;
+        return false;
+    }
+
+    QByteArrayView token;
+    while (tokenizer.next(&token)) {
+        result->push_back(QString::fromUtf8(token));
     }
 
-    return parseParams(params, options);
+    return true;
+}
+
+bool Params::readArguments(const QStringList &paramsArray, QStringList *result, QStringList *config) {
+    QStringList arguments;
+    if (!expandArguments(paramsArray, &arguments, 0)) {
+        return false;
+    }
+
+    QString configPath;
+    for (qsizetype i = arguments.size() - 1; i >= 0 && configPath.isEmpty(); --i) {
+        if (arguments[i] == "-config" && i < arguments.size() - 1) {
+            configPath = arguments[i + 1];
+        } else if (arguments[i].startsWith("-config=")) {
+            configPath = arguments[i].mid(8);
+        }
+    }
+
+    if (configPath.size() && !expandArguments({"@" + configPath}, config, 0)) {
+        return false;
+    }
+
+    result->swap(arguments);
+    return true;
+}
+
+bool Params::parseParams(const int argc, const char *argv[], const OptionsDataList& options) {
+    StartupProfiler::Scope scope("Params::parseParams");
+
+    publish({});
+    registry = {};
+    subcommands = {};
+    activeSubcommand = nullptr;
+    resetHelp(OptionsDataList{}.unite(options).unite(availableArguments()));
+
+    OptionsDataList availableOptions;
+    parseAvailableOptions(userOptions, &availableOptions, nullptr);
+
+    return parseArgv(argc, argv, availableOptions);
 }
 
 bool Params::parseParams(int argc, char *argv[], const OptionsDataList& options) {
@@ -205,12 +983,95 @@ bool Params::parseParams(int argc, char *argv[], const OptionsDataList& options)
 }
 
 bool Params::parseParams(const QStringList &paramsArray, const OptionsDataList &options) {
-    params.clear();
+    StartupProfiler::Scope scope("Params::parseParams");
+
+    publish({});
+    registry = {};
+    subcommands = {};
+    activeSubcommand = nullptr;
+    resetHelp(OptionsDataList{}.unite(options).unite(availableArguments()));
+
     OptionsDataList availableOptions;
+    parseAvailableOptions(userOptions, &availableOptions, nullptr);
+
+    return parseParamsPrivate(paramsArray, availableOptions);
+}
+
+bool Params::parseParams(const int argc, const char *argv[], const OptionsRegistryView &options) {
+    StartupProfiler::Scope scope("Params::parseParams");
+
+    publish({});
+    registry = options;
+    subcommands = {};
+    activeSubcommand = nullptr;
+    resetHelp();
 
-    parseAvailableOptions(OptionsDataList{}.unite(options).unite(availableArguments()),
-                          &availableOptions,
-                          &userHelp);
+    return parseArgv(argc, argv, {});
+}
+
+bool Params::parseParams(int argc, char *argv[], const OptionsRegistryView &options) {
+    return parseParams(argc, const_cast<const char**>(argv), options);
+}
+
+bool Params::parseParams(const int argc, const char *argv[], const SubcommandsView &commands) {
+
+    const SubcommandDefinition* command = nullptr;
+    if (argc > 1 && argv[1][0] != '-') {
+        command = commands.find(QByteArrayView(argv[1]));
+    }
+
+    // without subcommand only the builtin options are available.
+    const OptionsRegistryView options = (command && command->options.count)? command->options:
+                                                                               builtinOptions.view();
+
+    bool result = false;
+    if (command) {
+        result = parseParams(argc - 1, argv + 1, options);
+    } else if (argc > 1 && argv[1][0] != '-') {
+        parseParams(1, argv, options);
+        qCritical() << QString("The '%0' command not exists!"
+                               " You use wrong command name,"
+                               " please check the help before run your commnad.").
+                       arg(QString::fromUtf8(argv[1]));
+    } else {
+        result = parseParams(argc, argv, options);
+    }
+
+    subcommands = commands;
+    activeSubcommand = command;
+
+    return result;
+}
+
+bool Params::parseParams(int argc, char *argv[], const SubcommandsView &commands) {
+    return parseParams(argc, const_cast<const char**>(argv), commands);
+}
+
+const SubcommandDefinition *Params::subcommand() {
+    return activeSubcommand;
+}
+
+int Params::execSubcommand() {
+    if (!(activeSubcommand && activeSubcommand->handler)) {
+        return 1;
+    }
+
+    return activeSubcommand->handler();
+}
+
+bool Params::parseParams(const QStringList &paramsArray, const OptionsRegistryView &options) {
+    StartupProfiler::Scope scope("Params::parseParams");
+
+    publish({});
+    registry = options;
+    subcommands = {};
+    activeSubcommand = nullptr;
+    resetHelp();
+
+    return parseParamsPrivate(paramsArray, {});
+}
+
+bool Params::initExecutablePath() {
 
 #ifdef Q_OS_WIN
     char buffer[MAX_PATH];
@@ -246,22 +1107,364 @@ bool Params::parseParams(const QStringList &paramsArray, const OptionsDataList &
     appName =  QCoreApplication::applicationName();
 #endif
 
-    if (!appPath.size()) {
+    return appPath.size();
+}
+
+bool Params::parseParamsPrivate(const QStringList &paramsArray, const OptionsDataList &availableOptions) {
+
+    if (!initExecutablePath()) {
         return false;
     }
 
-    if (!optionsForEach(paramsArray, availableOptions)) {
+    QHash<QString, QString> values;
+    QHash<QString, QVariant> typed;
+    QSet<QString> fromConfig;
+    OptionsDataList usedOptions;
+
+    const bool parsed = readParams(paramsArray, availableOptions, registry, values, typed, fromConfig, usedOptions);
+    publish(values, typed, fromConfig);
+
+    for (auto it = usedOptions.cbegin(); it != usedOptions.cend(); ++it) {
+        if (!inputOptions.contains(it.key())) {
+            inputOptions.insert(it.key(), it.value());
+        }
+    }
+
+    if (!parsed) {
+        applyStartupProfile();
         return false;
     }
 
-    printWorkingOptions();
+    rememberArguments(paramsArray, {}, {}, availableOptions, registry);
+    applyParsedOptions();
+
+    return true;
+}
+
+bool Params::readParams(const QStringList &paramsArray,
+                        const OptionsDataList &availableOptions,
+                        const OptionsRegistryView &options,
+                        QHash<QString, QString> &values,
+                        QHash<QString, QVariant> &typed,
+                        QSet<QString> &fromConfig,
+                        OptionsDataList &usedOptions) {
+
+    QStringList arguments;
+    QStringList config;
+    QHash<QString, QString> argumentsValues;
+    QHash<QString, QVariant> argumentsTyped;
+
+    // options of the config file are parsed first, so the command line overrides them.
+    const bool parsed = readArguments(paramsArray, &arguments, &config) &&
+                        optionsForEach(config, availableOptions, options, values, typed, usedOptions) &&
+                        optionsForEach(arguments, availableOptions, options, argumentsValues, argumentsTyped, usedOptions);
+
+    fromConfig = QSet<QString>(values.keyBegin(), values.keyEnd());
+    for (auto it = argumentsValues.cbegin(); it != argumentsValues.cend(); ++it) {
+        values.insert(it.key(), it.value());
+        typed.remove(it.key());
+        fromConfig.remove(it.key());
+    }
+    typed.insert(argumentsTyped);
+
+    return parsed;
+}
+
+bool Params::reload() {
+    StartupProfiler::Scope scope("Params::reload");
+
+    // all state of the parsing is taken from the reload source, so the static lists of the Params class are not touched here.
+    QStringList arguments;
+    OptionsDataList availableOptions;
+    OptionsRegistryView options;
+    if (!restoreArguments(&arguments, &availableOptions, &options)) {
+        qWarning() << "Params::reload: the arguments are not parsed yet.";
+        return false;
+    }
+
+    QHash<QString, QString> values;
+    QHash<QString, QVariant> typed;
+    QSet<QString> fromConfig;
+    OptionsDataList usedOptions;
+    if (!readParams(arguments, availableOptions, options, values, typed, fromConfig, usedOptions)) {
+        qCritical() << "Params::reload: failed to read the arguments, the current arguments are not changed.";
+        return false;
+    }
+
+    // keys that already resolved from the environment and settings will be checked too.
+    const auto resolved = resolvedLayers();
+
+    QSet<QString> changed;
+    {
+        QMutexLocker locker(&writeMutex());
+
+        const auto current = currentLocked();
+        for (auto it = values.cbegin(); it != values.cend(); ++it) {
+            auto old = current.values.constFind(it.key());
+            if (old == current.values.cend() || *old != it.value()) {
+                changed.insert(it.key());
+            }
+        }
+
+        for (auto it = current.values.cbegin(); it != current.values.cend(); ++it) {
+            if (!values.contains(it.key())) {
+                changed.insert(it.key());
+            }
+        }
+
+        ParamsData data;
+        data.values = values;
+        data.typed = typed;
+        data.fromConfig = fromConfig;
+        publishLocked(data);
+    }
+
+    for (auto it = resolved.cbegin(); it != resolved.cend(); ++it) {
+        if (value(it.key()) != it.value()) {
+            changed.insert(it.key());
+        }
+    }
+
+    if (changed.size()) {
+        notifySubscribers(changed);
+    }
 
     return true;
 }
 
+int Params::subscribe(const ParamsListener &listener) {
+    if (auto list = subscribers()) {
+        QMutexLocker locker(&list->lock);
+        const int id = ++list->lastId;
+        list->listeners.insert(id, listener);
+        return id;
+    }
+
+    return 0;
+}
+
+void Params::unsubscribe(int id) {
+    if (auto list = subscribers()) {
+        QMutexLocker locker(&list->lock);
+        list->listeners.remove(id);
+    }
+}
+
+bool Params::parseArgv(int argc, const char *argv[], const OptionsDataList &availableOptions) {
+
+    // arguments files and config are expanded by the full parsing.
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] == '@' ||
+            (argv[i][0] == '-' && QByteArrayView(argv[i]).startsWith("-config"))) {
+
+            QStringList params;
+            for (int j = 1; j < argc; j++) {
+                params.push_back(argv[j]);
+            }
+
+            return parseParamsPrivate(params, availableOptions);
+        }
+    }
+
+    if (!initExecutablePath()) {
+        return false;
+    }
+
+    ParamsData data;
+
+    // all arguments are copied into one buffer, the parsed keys and values are views of this buffer.
+    std::vector<QByteArrayView> tokens;
+    tokens.reserve(argc);
+
+    qsizetype size = 0;
+    for (int i = 1; i < argc; i++) {
+        size += qstrlen(argv[i]);
+    }
+
+    data.rawData.reserve(size);
+    for (int i = 1; i < argc; i++) {
+        const qsizetype begin = data.rawData.size();
+        data.rawData.append(argv[i]);
+        tokens.push_back(QByteArrayView(data.rawData.constData() + begin, data.rawData.size() - begin));
+    }
+
+    std::vector<QPair<QByteArrayView, QByteArrayView>> params;
+    const bool parsed = rawOptionsForEach(tokens, availableOptions, params, data.typed);
+
+    data.raw.reserve(params.size());
+    for (const auto& param : params) {
+        data.raw.push_back(RawParam{param.first.data() - data.rawData.constData(), param.first.size(),
+                                    param.second.data() - data.rawData.constData(), param.second.size()});
+    }
+
+    {
+        QMutexLocker locker(&writeMutex());
+        publishLocked(data);
+    }
+
+    if (!parsed) {
+        applyStartupProfile();
+        return false;
+    }
+
+    std::vector<qsizetype> sizes;
+    sizes.reserve(tokens.size());
+    for (const auto& token : tokens) {
+        sizes.push_back(token.size());
+    }
+
+    rememberArguments({}, data.rawData, sizes, availableOptions, registry);
+    applyParsedOptions();
+
+    return true;
+}
+
+bool Params::rawOptionsForEach(const std::vector<QByteArrayView> &tokens,
+                               const OptionsDataList &availableOptions,
+                               std::vector<QPair<QByteArrayView, QByteArrayView>> &params,
+                               QHash<QString, QVariant> &typed) {
+
+    params.reserve(tokens.size());
+
+    // the available options are empty if the compile-time registry is used.
+    const OptionsLookup lookup(availableOptions);
+    QSet<const OptionData*> usedOptions;
+
+    for (size_t i = 0 ; i < tokens.size(); ++i) {
+
+        const QByteArrayView token = tokens[i];
+        if (token.isEmpty()) {
+            continue;
+        }
+
+        const bool withArgument = token[0] == '-';
+        bool hasArgument = false;
+
+        // flags have empty value, and missing argument has null value, so it will not be converted.
+        QByteArrayView name = token;
+        QByteArrayView value;
+
+        const qsizetype separator = token.indexOf('=');
+        if (separator > 0) {
+            // the key=value form.
+            name = token.first(separator);
+            value = token.sliced(separator + 1);
+            hasArgument = true;
+        } else if (withArgument) {
+            hasArgument = i < (tokens.size() - 1) &&
+                          tokens[i + 1].size() &&
+                          tokens[i + 1][0] != '-';
+            if (hasArgument) {
+                value = tokens[++i];
+            }
+        } else {
+            value = QByteArrayView(token.data() + token.size(), 0);
+        }
+
+        QVariant converted;
+        if (registry.count) {
+            auto definition = registry.find(name);
+            if (!definition) {
+                definition = builtinOptions.view().find(name);
+            }
+
+            const bool plain = definition &&
+                               definition->type == OptionType::String &&
+                               !definition->depricatedMsg[0];
+
+            // only unknown, depricated and typed options are converted to the OptionData object.
+            if (!plain) {
+                if (!checkOption((definition)? definition->toOptionData(): OptionData{{}},
+                                 QString::fromUtf8(name), QString::fromUtf8(value), &converted)) {
+                    return false;
+                }
+            }
+
+            if (definition) {
+                inputDefinitions.push_back(definition);
+            }
+        } else {
+            const auto option = lookup.find(name);
+            const bool found = option != lookup.options.cend();
+            const bool plain = found &&
+                               option->type() == OptionType::String &&
+                               !option->isDepricated();
+
+            // only unknown, depricated and typed options are converted to QString.
+            if (!plain) {
+                const QString rawName = QString::fromUtf8(name);
+                const OptionData optionData = (found)? *option: OptionData{{}};
+
+                // values of the string options are not checked, so they are not converted.
+                const QString rawValue = (optionData.type() != OptionType::String)? QString::fromUtf8(value): QString();
+                if (!checkOption(optionData, rawName, rawValue, &converted)) {
+                    return false;
+                }
+
+                if (!found && !inputOptions.contains(rawName)) {
+                    inputOptions.insert(rawName, optionData);
+                }
+            }
+
+            // repeated options are added into the inputOptions list once.
+            if (found && !usedOptions.contains(&*option)) {
+                usedOptions.insert(&*option);
+                if (!inputOptions.contains(option.key())) {
+                    inputOptions.insert(option.key(), *option);
+                }
+            }
+        }
+
+        if (withArgument && !hasArgument) {
+            qCritical() << "Missing argument for " + QString::fromUtf8(name);
+            return false;
+        }
+
+        const QByteArrayView key = (withArgument)? name.sliced(1): name;
+        params.push_back({key, value});
+
+        if (converted.isValid()) {
+            typed[QString::fromUtf8(key)] = converted;
+        }
+    }
+
+    return true;
+}
+
+void Params::materializeInputOptions() {
+    for (auto definition : std::as_const(inputDefinitions)) {
+        const QString key = QString::fromUtf8(definition->key);
+        if (!inputOptions.contains(key)) {
+            inputOptions.insert(key, definition->toOptionData());
+        }
+    }
+
+    inputDefinitions.clear();
+}
+
+void Params::applyParsedOptions() {
+    applyStartupProfile();
+    printWorkingOptions();
+}
+
+void Params::applyStartupProfile() {
+    if (isEndable("startupProfile")) {
+        StartupProfiler::reportAtExit(getArg("startupProfile"));
+    } else {
+        StartupProfiler::disable();
+    }
+}
+
 void Params::printWorkingOptions() {
+    // the table is not required on other levels, so the arguments are not converted.
+    if (!isDebug()) {
+        return;
+    }
+
     qDebug() << "--- Working options table start ---";
 
+    const auto params = getUserParamsMap();
+
     QMap<QString, QString>::const_iterator iter = params.constBegin();
     while (iter != params.constEnd()) {
 
@@ -280,7 +1483,8 @@ void Params::printWorkingOptions() {
     qDebug() << "--- Working options table end ---";
 }
 
-bool Params::checkOption(const OptionData& optionData, const QString& rawOptionName) {
+bool Params::checkOption(const OptionData& optionData, const QString& rawOptionName,
+                         const QString &value, QVariant *converted) {
 
 #ifndef QA_ALLOW_NOT_SUPPORTED_OPTIONS
     if (!optionData.isValid()) {
@@ -314,6 +1518,15 @@ bool Params::checkOption(const OptionData& optionData, const QString& rawOptionN
 
     }
 
+    if (!value.isNull() && optionData.type() != OptionType::String) {
+        if (!optionData.convert(value, converted)) {
+            qCritical() << QString("The '%0' option has wrong value '%1'. Expected: %2").
+                           arg(rawOptionName, value, optionData.arguments());
+
+            return false;
+        }
+    }
+
     return true;
 }
 
@@ -321,10 +1534,14 @@ void Params::parseAvailableOptions(const OptionsDataList &availableOptionsListIn
                                    OptionsDataList *availableOptionsListOut,
                                    Help::Section *helpOut) {
 
-    if (!(availableOptionsListOut && helpOut))
+    if (!(availableOptionsListOut || helpOut))
         return;
 
-    helpOut->clear();
+    StartupProfiler::Scope scope("Params::parseAvailableOptions");
+
+    if (helpOut) {
+        helpOut->clear();
+    }
 
     QHash<QString, Help::Options> options;
     for (auto it = availableOptionsListIn.begin(); it != availableOptionsListIn.end(); ++it) {
@@ -346,17 +1563,54 @@ void Params::parseAvailableOptions(const OptionsDataList &availableOptionsListIn
 }
 
 QString Params::getArg(const QString& key,const QString& def) {
-    return params.value(key, def);
+    ParamsReader reader;
+    auto data = reader.data();
+
+    QString result;
+    return (data && data->find(key, &result))? result: def;
+}
+
+QString Params::getArg(const ParamKey &key, const QString &def) {
+    ParamsReader reader;
+    auto data = reader.data();
+    if (!data)
+        return def;
+
+    auto it = data->hashed.constFind(key.hash);
+    if (it == data->hashed.cend()) {
+        auto param = data->findRaw(key.hash, QUtf8StringView(key.name));
+        return (param)? QString::fromUtf8(data->rawValue(*param)): def;
+    }
+
+    if (QAnyStringView::equal(it->first, QUtf8StringView(key.name)))
+        return it->second;
+
+    QString result;
+    return (data->find(QString::fromUtf8(key.name), &result))? result: def;
 }
 
 void Params::setArg(const QString &key, const QString &val) {
-    params.insert(key, val);
+    QMutexLocker locker(&writeMutex());
+
+    auto data = currentLocked();
+    data.values.insert(key, val);
+    // the new value will be converted on read.
+    data.typed.remove(key);
+    data.fromConfig.remove(key);
+    publishLocked(data);
 }
 
 void Params::setEnable(const QString &key, bool enable) {
+    QMutexLocker locker(&writeMutex());
+
+    auto data = currentLocked();
     if (enable) {
-        params.insert(key, "");
+        data.values.insert(key, "");
     } else {
-        params.remove(key);
+        data.values.remove(key);
     }
+
+    data.typed.remove(key);
+    data.fromConfig.remove(key);
+    publishLocked(data);
 }
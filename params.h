@@ -8,11 +8,19 @@
 #ifndef PARAMS_H
 #define PARAMS_H
 
+#include <QByteArrayView>
+#include <QHash>
 #include <QMap>
+#include <QSet>
 #include <QVariant>
+#include <chrono>
+#include <functional>
+#include <vector>
 #include "quasarapp_global.h"
 #include "helpdata.h"
 #include "optiondata.h"
+#include "optionsregistry.h"
+#include "subcommands.h"
 
 namespace QuasarAppUtils {
 
@@ -41,11 +49,33 @@ enum VerboseLvl {
 #endif
 #endif
 
+/**
+ * @brief The ParamsSource enum contains sources of the parameters, ordered by priority.
+ * @see Params::value
+ */
+enum class ParamsSource {
+    /// the parameter is not found in any source.
+    None,
+    /// the parameter is passed on the command line (or by the @ response file).
+    Arguments,
+    /// the parameter is set by the environment variable with the Params::environmentPrefix prefix.
+    Environment,
+    /// the parameter is readed from the file of the -config option.
+    ConfigFile,
+    /// the parameter is taken from the defaults of the ISettings service.
+    Settings
+};
+
 /**
  * @brief The Params class Contains fonctions for working with input arguments and logs.
  * This Class support next comandline arguments.
  *  * **-verbose** (level 1 - 3) Shows debug log
  *  * **-fileLog** (path to file) Sets path of log file. Default it is path to executable file with suffix '.log'
+ *  * **-config** (path to file) Reads options from the file. Options of the command line override options of the file.
+ *
+ * Any argument in the form **@path** will be replaced by options from the file (response file).
+ * The file contains options separated by whitespaces, values with whitespaces can be quoted,
+ *  lines that begin with the # symbol are comments. Options can be written in the -key=value form.
  *
  * ### Usage
  *
@@ -64,6 +94,13 @@ class QUASARAPPSHARED_EXPORT Params
 public:
     Params() = delete;
 
+    /**
+     * @brief ParamsListener This is function that will be invoked after reloading of the arguments.
+     * @param changedKeys This is keys of the changed arguments.
+     * @see Params::subscribe
+     */
+    using ParamsListener = std::function<void(const QSet<QString>& changedKeys)>;
+
     /**
      * @brief parseParams Parse input data of started application.
      * @param argc Count of arguments.
@@ -93,6 +130,68 @@ public:
      */
     static bool parseParams(const QStringList& paramsArray, const OptionsDataList& options = {});
 
+    /**
+     * @brief parseParams Parse input data of started application with the compile-time registry of the options.
+     * Lookup of the options is one probe of the perfect hash, and the help will be built only on first use.
+     * @param argc Count of arguments.
+     * @param argv Array of arguments.
+     * @param options This is view of the static constexpr registry. See the makeOptionsRegistry function.
+     * @return true if all arguments read successful else false.
+     */
+    static bool parseParams(const int argc, const char *argv[], const OptionsRegistryView& options);
+
+    /**
+     * @brief parseParams Parse input data of started application with the compile-time registry of the options.
+     * @param argc Count of arguments.
+     * @param argv Array of arguments.
+     * @param options This is view of the static constexpr registry. See the makeOptionsRegistry function.
+     * @return true if all arguments read successful else false.
+     */
+    static bool parseParams(int argc, char *argv[], const OptionsRegistryView& options);
+
+    /**
+     * @brief parseParams Parse input data of started application with the compile-time registry of the options.
+     * @param paramsArray Arguments.
+     * @param options This is view of the static constexpr registry. See the makeOptionsRegistry function.
+     * @return true if all arguments read successful else false.
+     */
+    static bool parseParams(const QStringList& paramsArray, const OptionsRegistryView& options);
+
+    /**
+     * @brief parseParams Parse input data of started application with the compile-time table of the subcommands.
+     * The first argument is name of the subcommand (for example: tool build -threads 4),
+     *  it is found by one probe of the perfect hash and only options of the found subcommand are validated.
+     *  If the first argument is an option (begins with the '-' symbol) then only builtin options are available.
+     * @param argc Count of arguments.
+     * @param argv Array of arguments.
+     * @param commands This is view of the static constexpr table of the subcommands. See the makeSubcommands function.
+     * @return true if all arguments read successful else false. Returns false if the subcommand is not exists.
+     * @see Params::subcommand
+     * @see Params::execSubcommand
+     */
+    static bool parseParams(const int argc, const char *argv[], const SubcommandsView& commands);
+
+    /**
+     * @brief parseParams Parse input data of started application with the compile-time table of the subcommands.
+     * @param argc Count of arguments.
+     * @param argv Array of arguments.
+     * @param commands This is view of the static constexpr table of the subcommands. See the makeSubcommands function.
+     * @return true if all arguments read successful else false.
+     */
+    static bool parseParams(int argc, char *argv[], const SubcommandsView& commands);
+
+    /**
+     * @brief subcommand This method return the subcommand selected while parsing.
+     * @return definition of the subcommand or nullptr if the subcommand is not selected.
+     */
+    static const SubcommandDefinition* subcommand();
+
+    /**
+     * @brief execSubcommand This method invokes handler of the subcommand selected while parsing.
+     * @return exit code of the handler or 1 if the subcommand or handler is not exists.
+     */
+    static int execSubcommand();
+
     /**
      * @brief getArg return string value of a @a key if key is exits else return a @a def value.
      *  If a @a def value not defined retunr empty string.
@@ -102,6 +201,18 @@ public:
      */
     static QString getArg(const QString& key, const QString &def = {});
 
+    /**
+     * @brief getArg return string value of a @a key if key is exits else return a @a def value.
+     * The hash of the key calculated on compile time, so lookup do not hash the string.
+     * @code{cpp}
+     *  auto threads = Params::getArg(PARAM_KEY("threads"));
+     * @endcode
+     * @param key This is key created by the PARAM_KEY macro.
+     * @param def This is default value.
+     * @return string value of argument.
+     */
+    static QString getArg(const ParamKey& key, const QString &def = {});
+
     /**
      * @brief setArg sets a new value of a @a key.
      * @param key This is a name of sets option.
@@ -117,6 +228,88 @@ public:
      */
     static void setEnable(const QString& key, bool enable);
 
+    /**
+     * @brief value This method return value of the @a key merged from all sources of the parameters.
+     * Sources are checked in the next order: command line arguments, environment variables, config file and defaults of the settings (see the ISettings::defaultValue method).
+     * The sources of the key are merged on first access only, and the result is cached,
+     *  so the environment and settings are not enumerated on startup.
+     *
+     * Example:
+     * @code{cpp}
+     *  // -logDir /tmp/log, or QA_LOGDIR=/tmp/log, or default logDir value of the settings.
+     *  QString logDir = QuasarAppUtils::Params::value("logDir", "/var/log");
+     * @endcode
+     *
+     * @param key This is name of the parameter.
+     * @param def This is default value.
+     * @return value of the @a key or @a def if the @a key is not found in any source.
+     * @note The cache is reset when arguments are changed. If environment or settings are changed after first access to key, invoke the Params::invalidateLayers method.
+     * @see Params::sourceOf
+     */
+    static QString value(const QString& key, const QString& def = {});
+
+    /**
+     * @brief hasValue This method return true if the @a key found in any source of the parameters.
+     * @param key This is name of the parameter.
+     * @return true if the @a key is found else false.
+     * @see Params::value
+     */
+    static bool hasValue(const QString& key);
+
+    /**
+     * @brief sourceOf This method return source of the value of the @a key.
+     * @param key This is name of the parameter.
+     * @return source of the @a key or ParamsSource::None if the key is not found.
+     * @see Params::value
+     */
+    static ParamsSource sourceOf(const QString& key);
+
+    /**
+     * @brief setEnvironmentPrefix This method sets prefix of the environment variables that used by the Params::value method.
+     * Name of the variable is prefix with key in upper case, where all not alphanumeric symbols replaced by the _ symbol.
+     *  For example the log-dir key will be readed from the QA_LOG_DIR variable.
+     * @param prefix This is new prefix. The empty prefix disables the environment source. By default it is QA_.
+     */
+    static void setEnvironmentPrefix(const QString& prefix);
+
+    /**
+     * @brief environmentPrefix This method return prefix of the environment variables.
+     * @return prefix of the environment variables.
+     * @see Params::setEnvironmentPrefix
+     */
+    static QString environmentPrefix();
+
+    /**
+     * @brief invalidateLayers This method resets cache of the Params::value method.
+     * Invoke it after changes of the environment or settings.
+     */
+    static void invalidateLayers();
+
+    /**
+     * @brief reload This method reads again arguments of the last parsing (with the @ files and the -config file),
+     *  and replaces the current snapshot of the arguments by one atomic operation. After this subscribers will be notified about changed keys.
+     *  Keys that already read by the Params::value method are checked again in the environment and settings.
+     * @return true if arguments reloaded successful else false. If arguments can't be read, then current arguments are not changed.
+     * @note Changes of the setArg and setEnable methods will be dropped.
+     * @note The ParamsReloader and ControlSocket classes queue the reload into the main thread.
+     * @see ParamsReloader
+     * @see Params::subscribe
+     */
+    static bool reload();
+
+    /**
+     * @brief subscribe This method adds listener of the changes of the arguments. The listener is invoked by the Params::reload method in the thread of the reload.
+     * @param listener This is function that receive keys of the changed arguments.
+     * @return id of the listener, use it for unsubscribe.
+     */
+    static int subscribe(const ParamsListener& listener);
+
+    /**
+     * @brief unsubscribe This method removes listener of the changes of the arguments.
+     * @param id This is id of the listener returned by the Params::subscribe method.
+     */
+    static void unsubscribe(int id);
+
     /**
      * @brief isEndable This method check if enable a @a key argument.
      * @param key This is name of the validate arguments
@@ -124,6 +317,58 @@ public:
      */
     static bool isEndable(const QString& key);
 
+    /**
+     * @brief isEndable This method check if enable a @a key argument. The hash of the key calculated on compile time.
+     * @param key This is key created by the PARAM_KEY macro.
+     * @return true if argument enabled.
+     */
+    static bool isEndable(const ParamKey& key);
+
+    /**
+     * @brief getInt This method return integer value of the @a key.
+     * Values of the options with OptionType::Int type are converted once while parsing.
+     * @param key This is name of the option.
+     * @param def This is default value. Will be returned if the key is not exists or can't be converted.
+     * @return integer value of the @a key.
+     */
+    static qint64 getInt(const QString& key, qint64 def = 0);
+
+    /**
+     * @brief getBool This method return boolean value of the @a key.
+     * Values of the options with OptionType::Bool type are converted once while parsing. The option without value is true.
+     * @param key This is name of the option.
+     * @param def This is default value. Will be returned if the key is not exists or can't be converted.
+     * @return boolean value of the @a key.
+     */
+    static bool getBool(const QString& key, bool def = false);
+
+    /**
+     * @brief getDuration This method return duration value of the @a key (for example 500ms, 30s, 5m).
+     * Values of the options with OptionType::Duration type are converted once while parsing.
+     * @param key This is name of the option.
+     * @param def This is default value. Will be returned if the key is not exists or can't be converted.
+     * @return duration value of the @a key.
+     */
+    static std::chrono::milliseconds getDuration(const QString& key, std::chrono::milliseconds def = {});
+
+    /**
+     * @brief getSize This method return size in bytes of the @a key (for example 4K, 64M, 1G).
+     * Values of the options with OptionType::Size type are converted once while parsing.
+     * @param key This is name of the option.
+     * @param def This is default value. Will be returned if the key is not exists or can't be converted.
+     * @return size in bytes of the @a key.
+     */
+    static qint64 getSize(const QString& key, qint64 def = 0);
+
+    /**
+     * @brief getList This method return comma separated list value of the @a key.
+     * Values of the options with OptionType::List type are converted once while parsing.
+     * @param key This is name of the option.
+     * @param def This is default value. Will be returned if the key is not exists.
+     * @return list value of the @a key.
+     */
+    static QStringList getList(const QString& key, const QStringList& def = {});
+
     /**
      * @brief log This method print @a log text on console.
      * @param log This is printed text message.
@@ -185,15 +430,26 @@ public:
     /**
      * @brief getHelp This method return options help page.
      * @note Befor using of this method invoke the parseParams method. This is needed for generate the help message.
+     *  The help is built on first call after parsing, so the parseParams method do not spend time for it.
      * @return help of available options.
      */
     static const Help::Section& getHelp();
 
     /**
-     * @brief getUserParamsMap This method return const reference to the parsed arguments map.
+     * @brief getUserParamsMap This method return copy of the parsed arguments map.
      * @return A map object with parsed arguments.
+     * @see Params::snapshot
      */
-    static const QMap<QString, QString> &getUserParamsMap();
+    static QMap<QString, QString> getUserParamsMap();
+
+    /**
+     * @brief snapshot This method return current immutable snapshot of the parsed arguments.
+     * The snapshot is not changed by the next invokes of the setArg or setEnable methods, so use it for consistent read of the several arguments.
+     * @note This method is lock-free and do not copy arguments (the returned hash is implicitly shared),
+     *  except arguments of the main function that are not converted to QString yet, they are converted on each call.
+     * @return snapshot of the parsed arguments.
+     */
+    static QHash<QString, QString> snapshot();
 
     /**
      * @brief clearParsedData This method clear all parsed data.
@@ -220,8 +476,130 @@ public:
 
 private:
 
+    static bool parseParamsPrivate(const QStringList& paramsArray, const OptionsDataList& availableOptions);
+
+    /**
+     * @brief readParams This method reads arguments and the config file without publishing of them.
+     * @param paramsArray This is raw arguments.
+     * @param availableOptions This is available options. Ignored if the compile-time registry is used.
+     * @param options This is the compile-time registry of the parsing or empty view.
+     * @param values This is values of the arguments.
+     * @param typed This is converted values of the typed options.
+     * @param fromConfig This is keys that readed from the config file.
+     * @param usedOptions This is options that present in the arguments.
+     * @return true if all arguments read successful else false.
+     * @note This method does not change static members of the Params class, so it can be invoked by the Params::reload method on any thread.
+     */
+    static bool readParams(const QStringList& paramsArray,
+                           const OptionsDataList& availableOptions,
+                           const OptionsRegistryView& options,
+                           QHash<QString, QString>& values,
+                           QHash<QString, QVariant>& typed,
+                           QSet<QString>& fromConfig,
+                           OptionsDataList& usedOptions);
+
+    /**
+     * @brief parseArgv This method parses arguments of the main function without conversion to QString.
+     * All arguments are copied into one buffer, and keys and values are stored as views of this buffer.
+     *  The values will be converted to QString only on read. Typed options are converted while parsing.
+     * @note If arguments contain the @path or -config options, then they will be parsed by the parseParamsPrivate method.
+     * @param argc Count of arguments.
+     * @param argv Array of arguments.
+     * @param availableOptions This is available options. Ignored if the compile-time registry is used.
+     * @return true if all arguments read successful else false.
+     */
+    static bool parseArgv(int argc, const char *argv[], const OptionsDataList& availableOptions);
+
+    /**
+     * @brief rawOptionsForEach This is same as optionsForEach method, but works with not converted arguments.
+     * @param tokens This is views of the arguments.
+     * @param availableOptions This is available options. Ignored if the compile-time registry is used.
+     * @param params This is parsed keys and values (views of the @a tokens).
+     * @param typed This is converted values of the typed options.
+     * @return true if all arguments read successful else false.
+     */
+    static bool rawOptionsForEach(const std::vector<QByteArrayView>& tokens,
+                                  const OptionsDataList &availableOptions,
+                                  std::vector<QPair<QByteArrayView, QByteArrayView>>& params,
+                                  QHash<QString, QVariant>& typed);
+
+    /**
+     * @brief initExecutablePath This method initializes path and name of the current executable.
+     * @return true if path of the executable is found else false.
+     */
+    static bool initExecutablePath();
+
+    /**
+     * @brief applyParsedOptions This method applies builtin options (-startupProfile) after successful parsing.
+     */
+    static void applyParsedOptions();
+
+    /**
+     * @brief applyStartupProfile This method schedules report of the startup profiler if the -startupProfile option is passed, else disables the profiler.
+     */
+    static void applyStartupProfile();
+
+    /**
+     * @brief materializeInputOptions This method converts used options of the compile-time registry to the inputOptions list.
+     *  The conversion is delayed until the help is required.
+     */
+    static void materializeInputOptions();
+
+    /**
+     * @brief resetHelp This method drops the built help and rendered help page.
+     * @param options This is available options of the new parsing. The help will be built from them by the getHelp method.
+     */
+    static void resetHelp(const OptionsDataList& options = {});
+
+    /**
+     * @brief findOption This method finds option by the @a name in the compile-time registry @a options if it is not empty else in the @a availableOptions.
+     */
+    static OptionData findOption(const QString& name,
+                                 const OptionsDataList& availableOptions,
+                                 const OptionsRegistryView& options);
+
     static bool optionsForEach(const QStringList& paramsArray,
-                               const OptionsDataList &availableOptions);
+                               const OptionsDataList &availableOptions,
+                               const OptionsRegistryView& options,
+                               QHash<QString, QString>& values,
+                               QHash<QString, QVariant>& typed,
+                               OptionsDataList& usedOptions);
+
+    /**
+     * @brief readArguments This method prepares the @a paramsArray for parsing.
+     * All @path tokens will be replaced by options from the file, and options of the -config file will be readed separately.
+     * @param paramsArray This is raw command line arguments.
+     * @param result This is expanded arguments.
+     * @param config This is options of the -config file.
+     * @return true if all arguments files readed successful else false.
+     */
+    static bool readArguments(const QStringList& paramsArray, QStringList* result, QStringList* config);
+
+    /**
+     * @brief expandArguments This method replaces recursively all @path tokens of the @a paramsArray by options from the file.
+     * @param paramsArray This is arguments list.
+     * @param result This is expanded arguments.
+     * @param depth This is current nesting level of the arguments files.
+     * @return true if all arguments files readed successful else false.
+     */
+    static bool expandArguments(const QStringList& paramsArray, QStringList* result, int depth);
+
+    /**
+     * @brief readArgumentsFile This method reads tokens of the arguments file.
+     * @param path This is path to the arguments file.
+     * @param result This is list of the readed tokens.
+     * @return true if file readed successful else false.
+     * @see ArgumentsTokenizer
+     */
+    static bool readArgumentsFile(const QString& path, QStringList* result);
+
+    /**
+     * @brief publish This method replaces current snapshot of the arguments by the @a values.
+     * Readers that use the old snapshot will finish with it, and the old snapshot will be destroyed after them.
+     */
+    static void publish(const QHash<QString, QString>& values,
+                        const QHash<QString, QVariant>& typed = {},
+                        const QSet<QString>& fromConfig = {});
 
     /**
      * @brief Traverse @a params and output its content (all the working
@@ -231,27 +609,38 @@ private:
     static void printWorkingOptions();
 
     /**
-     * @brief checkOption return tru if the option is supported
+     * @brief checkOption return tru if the option is supported and the @a value can be converted to type of the option.
      * @param option checked option
+     * @param value This is value of the option. Null value will not be checked.
+     * @param converted This is converted value of the typed option.
      * @return true if option is supported
      */
-    static bool checkOption(const OptionData &option, const QString &rawOptionName);
+    static bool checkOption(const OptionData &option, const QString &rawOptionName,
+                            const QString& value = {}, QVariant* converted = nullptr);
 
     /**
      * @brief parseAvailableOptions This is private method for parsing availabel options.
      * @param availableOptionsListIn input data of the available options.
-     * @param availableOptionsListOut hash of available options wher key it options name and value it is options data
-     * @param helpOut This is help object that generated from the
+     * @param availableOptionsListOut hash of available options wher key it options name and value it is options data. Can be nullptr.
+     * @param helpOut This is help object that generated from the available options. Can be nullptr, so the help will not be built.
      */
     static void parseAvailableOptions(const OptionsDataList& availableOptionsListIn,
                                       OptionsDataList* availableOptionsListOut,
                                       Help::Section* helpOut);
 
 
-    static QMap<QString, QString> params;
     static OptionsDataList inputOptions;
+    static OptionsRegistryView registry;
+    static std::vector<const OptionDefinition*> inputDefinitions;
+    static SubcommandsView subcommands;
+    static const SubcommandDefinition* activeSubcommand;
 
     static Help::Section userHelp;
+    // available options of the last parsing, the help is built from them only when it is required.
+    static OptionsDataList userOptions;
+    // rendered help page, cached for the helpPageWidth width of the console.
+    static QByteArray helpPage;
+    static int helpPageWidth;
     static QString appPath;
     static QString appName;
 
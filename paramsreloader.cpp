@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "paramsreloader.h"
+#include "params.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QMutex>
+#include <QThread>
+
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+#include <cerrno>
+#include <csignal>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <unistd.h>
+#define QA_SIGNALFD_SUPPORTED
+#endif
+
+namespace QuasarAppUtils {
+
+namespace {
+
+/**
+ * @brief The ReloaderData struct contains state of the reloader thread.
+ */
+struct ReloaderData {
+    QMutex lock;
+    QThread* thread = nullptr;
+    int signalFd = -1;
+    // used for wake up of the thread while stopping.
+    int stopFd = -1;
+};
+
+ReloaderData& reloaderData() {
+    static ReloaderData data;
+    return data;
+}
+
+#ifdef QA_SIGNALFD_SUPPORTED
+void reloaderLoop(int signalFd, int stopFd) {
+    pollfd fds[2] = {{signalFd, POLLIN, 0}, {stopFd, POLLIN, 0}};
+
+    while (true) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+
+            qCritical() << "ParamsReloader: poll failed, errno:" << errno;
+            return;
+        }
+
+        if (fds[1].revents) {
+            return;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            signalfd_siginfo info;
+            if (read(signalFd, &info, sizeof(info)) != sizeof(info)) {
+                continue;
+            }
+
+            qInfo() << "ParamsReloader: SIGHUP received, reloading of the arguments.";
+
+            // the reload reads the settings, so it is executed in the main thread if the application exists.
+            if (auto app = QCoreApplication::instance()) {
+                QMetaObject::invokeMethod(app, []() {
+                    Params::reload();
+                }, Qt::QueuedConnection);
+            } else {
+                Params::reload();
+            }
+        }
+    }
+}
+#endif
+
+}
+
+bool ParamsReloader::start() {
+#ifdef QA_SIGNALFD_SUPPORTED
+    auto& data = reloaderData();
+    QMutexLocker locker(&data.lock);
+
+    if (data.thread) {
+        return true;
+    }
+
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGHUP);
+
+    // the signal should be blocked for delivery by the signalfd.
+    if (pthread_sigmask(SIG_BLOCK, &mask, nullptr) != 0) {
+        qCritical() << "ParamsReloader: failed to block the SIGHUP signal.";
+        return false;
+    }
+
+    data.signalFd = signalfd(-1, &mask, SFD_CLOEXEC);
+    if (data.signalFd < 0) {
+        qCritical() << "ParamsReloader: failed to create the signalfd, errno:" << errno;
+        return false;
+    }
+
+    data.stopFd = eventfd(0, EFD_CLOEXEC);
+    if (data.stopFd < 0) {
+        qCritical() << "ParamsReloader: failed to create the eventfd, errno:" << errno;
+        close(data.signalFd);
+        data.signalFd = -1;
+        return false;
+    }
+
+    const int signalFd = data.signalFd;
+    const int stopFd = data.stopFd;
+    data.thread = QThread::create([signalFd, stopFd]() {
+        reloaderLoop(signalFd, stopFd);
+    });
+
+    data.thread->setObjectName("ParamsReloader");
+    data.thread->start();
+
+    return true;
+#else
+    qWarning() << "ParamsReloader: reload by the SIGHUP signal is not supported on this platform.";
+    return false;
+#endif
+}
+
+void ParamsReloader::stop() {
+#ifdef QA_SIGNALFD_SUPPORTED
+    auto& data = reloaderData();
+    QMutexLocker locker(&data.lock);
+
+    if (!data.thread) {
+        return;
+    }
+
+    const uint64_t value = 1;
+    if (write(data.stopFd, &value, sizeof(value)) != sizeof(value)) {
+        qWarning() << "ParamsReloader: failed to wake up the reloader thread.";
+    }
+
+    data.thread->wait();
+    delete data.thread;
+    data.thread = nullptr;
+
+    close(data.signalFd);
+    close(data.stopFd);
+    data.signalFd = -1;
+    data.stopFd = -1;
+#endif
+}
+
+bool ParamsReloader::isActive() {
+    auto& data = reloaderData();
+    QMutexLocker locker(&data.lock);
+    return data.thread;
+}
+
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef PARAMSRELOADER_H
+#define PARAMSRELOADER_H
+
+#include "quasarapp_global.h"
+
+namespace QuasarAppUtils {
+
+/**
+ * @brief The ParamsReloader class reloads arguments of the application on the SIGHUP signal without restart.
+ * The signal is received by the signalfd on the dedicated thread, so the reload is never executed in the signal context.
+ * The reload itself is queued into the main thread (the thread of the QCoreApplication object), so it requires the running event loop.
+ * After the reload the Params snapshot is replaced and subscribers of the Params class are notified about changed keys
+ *  (for example the QALogger applies the new -verbose level immediately).
+ *
+ * Example:
+ * @code{cpp}
+ *  int main(int argc, char* argv[]) {
+ *      // should be invoked before creating of any thread.
+ *      QuasarAppUtils::ParamsReloader::start();
+ *
+ *      QCoreApplication app(argc, argv);
+ *      QuasarAppUtils::Params::parseParams(argc, argv);
+ *      ...
+ *  }
+ *  // kill -HUP <pid> rereads the -config file and the environment.
+ * @endcode
+ *
+ * @note This class is supported only on Linux. On other platforms the start method return false.
+ * @warning The SIGHUP is blocked in the thread that invokes the start method, and other threads inherit this mask only if they are created after.
+ *  If any thread that created before do not block SIGHUP then the signal can be delivered to it and terminate the application.
+ * @see Params::reload
+ * @see Params::subscribe
+ */
+class QUASARAPPSHARED_EXPORT ParamsReloader
+{
+public:
+    ParamsReloader() = delete;
+
+    /**
+     * @brief start This method blocks the SIGHUP signal and starts the thread that reloads arguments on this signal.
+     * @return true if the reloader started successful or is already started else false.
+     */
+    static bool start();
+
+    /**
+     * @brief stop This method stops the thread of the reloader. The SIGHUP signal stays blocked.
+     */
+    static void stop();
+
+    /**
+     * @brief isActive This method return true if the reloader is started.
+     * @return true if the reloader is started else false.
+     */
+    static bool isActive();
+};
+
+}
+
+#endif // PARAMSRELOADER_H
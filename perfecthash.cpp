@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "perfecthash.h"
+#include <QtLogging>
+
+namespace QuasarAppUtils {
+
+uint32_t calculateCrc32Utf8(QStringView key) {
+    uint32_t crc = 0xFFFFFFFF;
+    auto feed = [&crc](uint32_t byte) {
+        crc = crc32Table[(crc ^ byte) & 0xFF] ^ (crc >> 8);
+    };
+
+    // encode to utf8 on the fly, so the hash is equal to the LITIRAL_CRC32 of the same key.
+    for (qsizetype i = 0; i < key.size(); ++i) {
+        uint32_t code = key[i].unicode();
+
+        if (QChar::isHighSurrogate(code) && i + 1 < key.size() && key[i + 1].isLowSurrogate()) {
+            code = QChar::surrogateToUcs4(key[i].unicode(), key[i + 1].unicode());
+            ++i;
+        }
+
+        if (code < 0x80) {
+            feed(code);
+        } else if (code < 0x800) {
+            feed(0xC0 | (code >> 6));
+            feed(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            feed(0xE0 | (code >> 12));
+            feed(0x80 | ((code >> 6) & 0x3F));
+            feed(0x80 | (code & 0x3F));
+        } else {
+            feed(0xF0 | (code >> 18));
+            feed(0x80 | ((code >> 12) & 0x3F));
+            feed(0x80 | ((code >> 6) & 0x3F));
+            feed(0x80 | (code & 0x3F));
+        }
+    }
+
+    return crc ^ 0xFFFFFFFF;
+}
+
+void perfectHashError(const char *message) {
+    qFatal("%s", message);
+}
+
+}
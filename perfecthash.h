@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef PERFECTHASH_H
+#define PERFECTHASH_H
+
+#include "quasarapp_global.h"
+#include "crc32constexper.h"
+#include <QAnyStringView>
+#include <QByteArrayView>
+#include <QStringView>
+
+namespace QuasarAppUtils {
+
+/**
+ * @brief perfectHashMix This function mixes the @a hash with the @a seed. Used by the PerfectHashTable class.
+ */
+constexpr uint32_t perfectHashMix(uint32_t hash, uint32_t seed) {
+    uint32_t x = hash ^ (seed * 0x9E3779B9u);
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35u;
+    x ^= x >> 16;
+    return x;
+}
+
+/**
+ * @brief calculateCrc32Utf8 This function calculates crc32 hash of the utf8 representation of the @a key without conversion of the string.
+ * @param key This is string for calculate hash.
+ * @return crc32 hash of the key. It is equals LITIRAL_CRC32 of the same key.
+ */
+uint32_t QUASARAPPSHARED_EXPORT calculateCrc32Utf8(QStringView key);
+
+/**
+ * @brief perfectHashError This function reports error of the building perfect hash table.
+ * @note This function is not constexpr, so if it will be invoked while compile-time building, then compilation fails.
+ */
+void QUASARAPPSHARED_EXPORT perfectHashError(const char* message);
+
+/**
+ * @brief nextPowerOf2 This function return minimal power of 2 that bigger or equal @a value.
+ */
+constexpr size_t nextPowerOf2(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+/**
+ * @brief The PerfectHashView struct is not template view of the PerfectHashTable.
+ * The @a Item type should contains the key (utf8 string) and hash (crc32 of the key) members.
+ * @see PerfectHashTable::view
+ */
+template <class Item>
+struct PerfectHashView {
+    const Item* items = nullptr;
+    const int32_t* slots = nullptr;
+    const uint32_t* seeds = nullptr;
+    size_t count = 0;
+    size_t slotsCount = 0;
+    size_t bucketsCount = 0;
+
+    /**
+     * @brief find This method finds item by hash of the key.
+     * @param hash This is crc32 hash of the key. See the LITIRAL_CRC32 macro.
+     * @return pointer to the item or nullptr if the item is not exists.
+     */
+    constexpr const Item* find(uint32_t hash) const {
+        if (!count)
+            return nullptr;
+
+        const uint32_t seed = seeds[hash & (bucketsCount - 1)];
+        const int32_t index = slots[perfectHashMix(hash, seed) & (slotsCount - 1)];
+        if (index < 0 || items[index].hash != hash)
+            return nullptr;
+
+        return &items[index];
+    }
+
+    /**
+     * @brief find This method finds item by key. This method do not allocate memory.
+     * @param key This is key of the item.
+     * @return pointer to the item or nullptr if the item is not exists.
+     */
+    const Item* find(QStringView key) const {
+        auto item = find(calculateCrc32Utf8(key));
+        if (item && QAnyStringView::equal(key, QUtf8StringView(item->key))) {
+            return item;
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief find This method finds item by utf8 @a key, for example by not converted argument of the command line.
+     *  This method do not allocate memory.
+     * @param key This is utf8 key of the item.
+     * @return pointer to the item or nullptr if the item is not exists.
+     */
+    const Item* find(QByteArrayView key) const {
+        auto item = find(calculateCrc32(key.data(), key.size()));
+        if (item && key == QByteArrayView(item->key)) {
+            return item;
+        }
+
+        return nullptr;
+    }
+};
+
+/**
+ * @brief The PerfectHashTable class is compile-time hash table without collisions.
+ * The table uses perfect hash (hash and displace), so lookup of the key is one probe.
+ * The @a Item type should contains the key (utf8 string) and hash (crc32 of the key) members.
+ * @note Keys should be unique, else compilation fails.
+ * @see SettingsDefaults
+ * @see OptionsRegistry
+ */
+template <class Item, size_t N>
+class PerfectHashTable
+{
+public:
+    static_assert(N > 0, "The table can't be empty");
+
+    static constexpr size_t slotsCount = nextPowerOf2(N * 2);
+    static constexpr size_t bucketsCount = nextPowerOf2((N + 3) / 4);
+
+    constexpr explicit PerfectHashTable(const std::array<Item, N>& items):
+        _items(items), _slots(), _seeds() {
+        build();
+    }
+
+    /**
+     * @brief find This method finds item by hash of the key.
+     * @param hash This is crc32 hash of the key. See the LITIRAL_CRC32 macro.
+     * @return pointer to the item or nullptr if the item is not exists.
+     */
+    constexpr const Item* find(uint32_t hash) const {
+        return view().find(hash);
+    }
+
+    /**
+     * @brief size This method return count of the items in the table.
+     */
+    constexpr size_t size() const {
+        return N;
+    }
+
+    /**
+     * @brief view This method return not template view of this table.
+     * @note The table should be alive while the view is used, so create the table as static constexpr object.
+     */
+    constexpr PerfectHashView<Item> view() const {
+        return PerfectHashView<Item>{_items.data(), _slots.data(), _seeds.data(), N, slotsCount, bucketsCount};
+    }
+
+private:
+    constexpr void build() {
+        for (size_t i = 0; i < slotsCount; ++i) {
+            _slots[i] = -1;
+        }
+
+        // group items by buckets.
+        std::array<size_t, bucketsCount + 1> offsets{};
+        for (size_t i = 0; i < N; ++i) {
+            offsets[(_items[i].hash & (bucketsCount - 1)) + 1]++;
+        }
+
+        for (size_t i = 0; i < bucketsCount; ++i) {
+            offsets[i + 1] += offsets[i];
+        }
+
+        std::array<size_t, N> members{};
+        std::array<size_t, bucketsCount> filled{};
+        for (size_t i = 0; i < N; ++i) {
+            const size_t bucket = _items[i].hash & (bucketsCount - 1);
+            members[offsets[bucket] + filled[bucket]++] = i;
+        }
+
+        // place biggest buckets first, while the table is empty.
+        std::array<size_t, bucketsCount> order{};
+        for (size_t i = 0; i < bucketsCount; ++i) {
+            order[i] = i;
+            for (size_t j = i; j > 0 && filled[order[j - 1]] < filled[order[j]]; --j) {
+                const size_t tmp = order[j - 1];
+                order[j - 1] = order[j];
+                order[j] = tmp;
+            }
+        }
+
+        for (size_t i = 0; i < bucketsCount; ++i) {
+            const size_t bucket = order[i];
+            const size_t size = filled[bucket];
+            if (!size)
+                break;
+
+            bool placed = false;
+            for (uint32_t seed = 0; seed < 0x10000 && !placed; ++seed) {
+                std::array<size_t, N> candidates{};
+                placed = true;
+
+                for (size_t k = 0; k < size && placed; ++k) {
+                    const auto& item = _items[members[offsets[bucket] + k]];
+                    const size_t slot = perfectHashMix(item.hash, seed) & (slotsCount - 1);
+                    placed = _slots[slot] < 0;
+
+                    for (size_t j = 0; j < k && placed; ++j) {
+                        placed = candidates[j] != slot;
+                    }
+
+                    candidates[k] = slot;
+                }
+
+                if (placed) {
+                    for (size_t k = 0; k < size; ++k) {
+                        _slots[candidates[k]] = static_cast<int32_t>(members[offsets[bucket] + k]);
+                    }
+
+                    _seeds[bucket] = seed;
+                }
+            }
+
+            if (!placed) {
+                perfectHashError("Failed to build the perfect hash table. Check that all keys are unique.");
+            }
+        }
+    }
+
+    std::array<Item, N> _items;
+    std::array<int32_t, slotsCount> _slots;
+    std::array<uint32_t, bucketsCount> _seeds;
+};
+
+}
+#endif // PERFECTHASH_H
@@ -7,6 +7,8 @@
 
 #include "qalogger.h"
 #include "params.h"
+#include "startupprofiler.h"
+#include <atomic>
 #include <iostream>
 
 #include <QCoreApplication>
@@ -19,7 +21,8 @@ namespace QuasarAppUtils {
 Q_GLOBAL_STATIC(QString, _logFile)
 
 static bool _toFile = false;
-static VerboseLvl _verboseLevel = Debug;
+// the level can be changed by the Params::reload method from other thread.
+static std::atomic<VerboseLvl> _verboseLevel{Debug};
 
 
 #define MESSAGE_PATTERN                                                                                           \
@@ -83,12 +86,22 @@ void messageHandler(QtMsgType type, const QMessageLogContext & context, const QS
 
 
 void QALogger::init() {
+    StartupProfiler::Scope scope("QALogger::init");
+
     qSetMessagePattern(MESSAGE_PATTERN);
     qInstallMessageHandler(messageHandler);
 
 
     _verboseLevel = Params::getVerboseLvl();
 
+    // the new verbose level is applied immediately after reloading of the arguments.
+    static const int subscription = Params::subscribe([](const QSet<QString>& changedKeys) {
+        if (changedKeys.contains("verbose")) {
+            _verboseLevel = Params::getVerboseLvl();
+        }
+    });
+    Q_UNUSED(subscription)
+
     if (Params::isEndable("fileLog")) {
         _toFile = true;
         QString path = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
@@ -107,6 +120,19 @@ void QALogger::init() {
 
 }
 
+void QALogger::setVerboseLevel(VerboseLvl lvl) {
+    _verboseLevel = lvl;
+}
+
+VerboseLvl QALogger::verboseLevel() {
+    return _verboseLevel;
+}
+
+void QALogger::flush() {
+    std::cout.flush();
+    std::cerr.flush();
+}
+
 QString QALogger::getLogFilePath() {
     return *_logFile;
 }
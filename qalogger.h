@@ -9,6 +9,7 @@
 #define QALOGGER_H
 
 #include "quasarapp_global.h"
+#include "params.h"
 
 #include <QFile>
 #include <QList>
@@ -52,12 +53,32 @@ public:
      * @brief init This method initialize logging of all qt message into file.
      * @note This function should be invokae after  parsing arguments.
      *  if you invoke this before parsing arguments, verbose level of logs will not created correct.
+     *  The verbose level will be updated after each reload of the arguments (see the Params::reload method).
      */
     void init();
 
     /**
      * @brief setVerboseLevel This method set verbose level of the logger.
      * @param lvl This is new verbose level.
+     * @note This method is thread-safe.
+     */
+    static void setVerboseLevel(VerboseLvl lvl);
+
+    /**
+     * @brief verboseLevel This method return current verbose level of the logger.
+     * @return verbose level of the logger.
+     */
+    static VerboseLvl verboseLevel();
+
+    /**
+     * @brief flush This method flushes the console streams of the logger.
+     * @note The log file is opened and closed for each message, so it is not required to flush it.
+     */
+    static void flush();
+
+    /**
+     * @brief getLogFilePath This method return path to the log file.
+     * @return path to the log file or empty string if logging into file is disabled.
      */
     static QString getLogFilePath();
 
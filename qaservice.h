@@ -8,15 +8,29 @@
 #ifndef QASERVICE_H
 #define QASERVICE_H
 
+#include "startupprofiler.h"
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <utility>
 namespace QuasarAppUtils {
 
+/**
+ * @brief The ServicePolicy enum contains policies of the instances of the Service class.
+ */
+enum class ServicePolicy {
+    /// one instance for all threads of the application.
+    Global,
+    /// each thread has own instance that will be created on the first use in the thread.
+    PerThread
+};
+
 /**
  * @brief The Service class is a template class for creating a singleton services objects.
  * This is manual control wrapper. You should be manually initializing your service object and manually deinitializing.
  * If you don't destroy your service, then service object will be automatically destroyed when application will be closed.
- * @warning If service was destroyed automatically, then destructor of your base class will be not invoked. Use The deinit method for this.
+ * The initialization is thread-safe and the instance method costs one atomic load, so services can be used from any thread.
  * @todo Remove the template Base class. Instead, it needs to use a general inherit paradigm
  *
  * **Examples**
@@ -62,8 +76,13 @@ namespace QuasarAppUtils {
  *  MyService* serviceInstance = MyService::autoInstance();
  *
  * @endcode
+ *
+ * **Per-thread services**
+ *
+ * Services that cheap to create but expensive to synchronize can use the ServicePolicy::PerThread policy.
+ * See the Service<Base, ServicePolicy::PerThread> specialization.
  */
-template<class Base>
+template<class Base, ServicePolicy Policy = ServicePolicy::Global>
 class Service
 {
 
@@ -72,18 +91,30 @@ public:
 
     /**
      * @brief initService This method initialize the @a Base object as a service.
-     * @param args This is argumets of a constructo of the @a Base class.
+     * @note This method is thread-safe. If two threads invoke this method at the same time, then only one object will be created.
      * @return instance pointer. If the service alredy initialized then return pointer to current service object.
      * @see instance
      * @see deinitService
      * @see autoInstance
      */
-    static inline std::unique_ptr<Base>& initService() {
+    static inline Base* initService() {
         auto& val = instancePrivat();
-        if(!val) {
-            val.reset(new Base());
+
+        Base* current = val.load(std::memory_order_acquire);
+        if (current) {
+            return current;
+        }
+
+        std::lock_guard<std::mutex> lock(initMutex());
+
+        current = val.load(std::memory_order_relaxed);
+        if (!current) {
+            StartupProfiler::Scope scope("Service::initService", Q_FUNC_INFO);
+            current = new Base();
+            val.store(current, std::memory_order_release);
         }
-        return val;
+
+        return current;
     }
 
     /**
@@ -93,47 +124,75 @@ public:
      *  If you initialize instance of your settings model on one libarary the this instance will be available only on your library or upper.
      *  Bot not on the QuasarApp lib so SettingsListner will not work.
      * @param obj This is inited settings object.
-     * @return true if the @a obj service was saved as a service object else false.
+     * @return true if the @a obj service was saved as a service object else false. If the service alredy initialized then the @a obj will be destroyed.
      */
     static bool initService(std::unique_ptr<Base> obj) {
         auto& val = instancePrivat();
-        if(!val) {
-            val = std::move(obj);
+
+        std::lock_guard<std::mutex> lock(initMutex());
+
+        if(!val.load(std::memory_order_relaxed)) {
+            val.store(obj.release(), std::memory_order_release);
             return true;
         }
         return false;
     };
 
+    /**
+     * @brief initService This method creates the service object by the @a factory if the service is not initialized.
+     * @param factory This is function that creates the service object. It is invoked under the lock of the initialization,
+     *  so if two threads invoke this method at the same time, then only one object will be created.
+     * @return true if the object of the @a factory was saved as a service object else false.
+     */
+    static bool initService(const std::function<std::unique_ptr<Base>()>& factory) {
+        auto& val = instancePrivat();
+
+        if (val.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(initMutex());
+
+        if (val.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        auto obj = factory();
+        if (!obj) {
+            return false;
+        }
+
+        val.store(obj.release(), std::memory_order_release);
+        return true;
+    }
+
     /**
      * @brief instance This method return pointerer to current service object.
      * @note If object was not initialized, then return false.
+     * @note This method is lock-free and costs one atomic load.
      * @return pointerer to current service object if service initialized else nullptr.
      * @see initService
      * @see deinitService
      * @see autoInstance
      */
     static Base* instance() {
-        return instancePrivat().get();
+        return instancePrivat().load(std::memory_order_acquire);
     }
 
     /**
      * @brief autoInstance This method return pointerer to current service object and if it is not inited try to initialize it use default constructor.
+     * @note This method is thread-safe.
      * @return pointerer to current service object if service initialized else nullptr.
      * @see instance
      */
     static Base* autoInstance() {
-        auto& val = instancePrivat();
-
-        if (!val) {
-            initService();
-        }
-
-        return val.get();
+        return initService();
     }
 
     /**
-     * @brief deinitService This is distructor method for the service.
+     * @brief deinitService This is distructor method for the service. The service object will be destroyed.
      * @note do nothink if this object alredy distroyed.
+     * @warning Make sure that other threads do not use the service object while it is destroying.
      * @see instance
      * @see initService
      * @see autoInstance
@@ -141,19 +200,167 @@ public:
     static void deinitService() {
         auto& val = instancePrivat();
 
-        if(val) {
-            val.release();
+        Base* current = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(initMutex());
+            current = val.exchange(nullptr, std::memory_order_acq_rel);
         }
+
+        // destroy out of the lock, because destructor can use other services.
+        delete current;
     }
 
 private:
-    static inline std::unique_ptr<Base>& instancePrivat() {
-        static std::unique_ptr<Base> instance = nullptr;
-        return instance;
+    /**
+     * @brief The Holder struct destroys the service object on exit of the application if it was not destroyed manually.
+     */
+    struct Holder {
+        std::atomic<Base*> instance{nullptr};
+
+        ~Holder() {
+            delete instance.load(std::memory_order_acquire);
+        }
+    };
+
+    static inline std::atomic<Base*>& instancePrivat() {
+        static Holder holder;
+        return holder.instance;
+    }
+
+    static inline std::mutex& initMutex() {
+        static std::mutex mutex;
+        return mutex;
     }
 
 };
 
+/**
+ * @brief The Service<Base, ServicePolicy::PerThread> class is a service that has own instance for each thread.
+ * The instance method returns instance of the current thread and creates it on the first use, so the service object
+ *  can be used without any synchronization.
+ * When the thread finishes (or the deinitService method invoked) the instance will be passed into the merge hook and destroyed,
+ *  so the hook can collect state of the thread into the shared object.
+ *
+ * **Example:**
+ *
+ * @code{cpp}
+ *
+ *  class Formatter: public QuasarAppUtils::Service<Formatter, QuasarAppUtils::ServicePolicy::PerThread> {
+ *      // some implementation
+ *  };
+ *
+ *  Formatter::setMergeHook([](Formatter& formatter) {
+ *      // collect statistics of the thread.
+ *  });
+ *
+ *  // returns formatter of the current thread.
+ *  Formatter::instance()->format(value);
+ *
+ * @endcode
+ *
+ * @note The merge hook will be invoked on the thread that finishes.
+ * @note Threads of the thread pools live long, so them instances will be merged only when the pool is destroyed.
+ */
+template<class Base>
+class Service<Base, ServicePolicy::PerThread>
+{
+
+public:
+    using MergeHook = std::function<void(Base&)>;
+
+    Service() {};
+
+    /**
+     * @brief initService This method initialize the @a Base object for the current thread.
+     * @return instance pointer of the current thread.
+     */
+    static inline Base* initService() {
+        auto& holder = threadHolder();
+        if (!holder.instance) {
+            holder.instance = new Base();
+        }
+
+        return holder.instance;
+    }
+
+    /**
+     * @brief instance This method return pointer to service object of the current thread. If the object is not exists then it will be created.
+     * @return pointer to service object of the current thread.
+     */
+    static Base* instance() {
+        return initService();
+    }
+
+    /**
+     * @brief autoInstance This method is same as the instance method.
+     * @return pointer to service object of the current thread.
+     */
+    static Base* autoInstance() {
+        return initService();
+    }
+
+    /**
+     * @brief deinitService This method merges and destroys service object of the current thread.
+     * @note do nothink if this object alredy distroyed.
+     */
+    static void deinitService() {
+        destroy(threadHolder().instance);
+    }
+
+    /**
+     * @brief setMergeHook This method sets hook that will be invoked with instance of the thread before destroying.
+     * @param hook This is merge function. Set empty function for disable merge.
+     */
+    static void setMergeHook(const MergeHook& hook) {
+        std::lock_guard<std::mutex> lock(hookMutex());
+        hookStorage() = hook;
+    }
+
+private:
+    /**
+     * @brief The ThreadHolder struct destroys the service object of the thread when the thread finishes.
+     */
+    struct ThreadHolder {
+        Base* instance = nullptr;
+
+        ~ThreadHolder() {
+            destroy(instance);
+        }
+    };
+
+    static void destroy(Base*& instance) {
+        if (!instance)
+            return;
+
+        MergeHook hook;
+        {
+            std::lock_guard<std::mutex> lock(hookMutex());
+            hook = hookStorage();
+        }
+
+        if (hook) {
+            hook(*instance);
+        }
+
+        delete instance;
+        instance = nullptr;
+    }
+
+    static inline ThreadHolder& threadHolder() {
+        thread_local ThreadHolder holder;
+        return holder;
+    }
+
+    static inline MergeHook& hookStorage() {
+        static MergeHook hook;
+        return hook;
+    }
+
+    static inline std::mutex& hookMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+};
 
 }
 #endif // QASERVICE_H
@@ -0,0 +1,310 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "serviceregistry.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QThreadPool>
+#include <QWaitCondition>
+#include <algorithm>
+
+namespace QuasarAppUtils {
+
+ServiceRegistry::ServiceRegistry() {
+
+}
+
+bool ServiceRegistry::add(const QString &name, const InitFunction &init,
+                          const QStringList &dependencies, bool mainThread) {
+    if (_nodes.contains(name)) {
+        qCritical() << "The service" << name << "already added into registry.";
+        return false;
+    }
+
+    Node node;
+    node.init = init;
+    node.mainThread = mainThread;
+    node.record.name = name;
+    node.record.dependencies = dependencies;
+
+    _nodes.insert(name, node);
+    _order.push_back(name);
+
+    return true;
+}
+
+bool ServiceRegistry::validate() const {
+    QHash<QString, int> pending;
+    QHash<QString, QStringList> dependents;
+
+    for (const auto& name : _order) {
+        const auto& dependencies = _nodes.value(name).record.dependencies;
+        for (const auto& dependency : dependencies) {
+            if (!_nodes.contains(dependency)) {
+                qCritical() << "The service" << name << "depends on unknown service" << dependency;
+                return false;
+            }
+
+            dependents[dependency].push_back(name);
+        }
+
+        pending.insert(name, dependencies.size());
+    }
+
+    QStringList ready;
+    for (const auto& name : _order) {
+        if (!pending.value(name))
+            ready.push_back(name);
+    }
+
+    int visited = 0;
+    while (ready.size()) {
+        const QString name = ready.takeLast();
+        ++visited;
+
+        for (const auto& dependent : dependents.value(name)) {
+            if (!--pending[dependent])
+                ready.push_back(dependent);
+        }
+    }
+
+    if (visited != _order.size()) {
+        QStringList cycle;
+        for (auto it = pending.cbegin(); it != pending.cend(); ++it) {
+            if (it.value())
+                cycle.push_back(it.key());
+        }
+
+        qCritical() << "The dependencies of the services contains cycle:" << cycle;
+        return false;
+    }
+
+    return true;
+}
+
+bool ServiceRegistry::start(int threads) {
+    if (!validate()) {
+        return false;
+    }
+
+    _startThread = QThread::currentThread();
+
+    // workers only read this map, so it is not changed while startup.
+    QHash<QString, Node*> nodes;
+    QHash<QString, int> pending;
+    QHash<QString, QStringList> dependents;
+
+    for (const auto& name : std::as_const(_order)) {
+        Node* node = &_nodes[name];
+        node->record.start = 0;
+        node->record.finish = 0;
+        node->record.thread = 0;
+        node->record.success = false;
+        node->record.skipped = false;
+        node->record.critical = false;
+
+        nodes.insert(name, node);
+        pending.insert(name, node->record.dependencies.size());
+
+        for (const auto& dependency : std::as_const(node->record.dependencies)) {
+            dependents[dependency].push_back(name);
+        }
+    }
+
+    QMutex mutex;
+    QWaitCondition condition;
+    QStringList mainQueue;
+    QHash<QThread*, int> threadIndexes;
+    threadIndexes.insert(_startThread, 0);
+
+    qsizetype left = _order.size();
+    bool success = true;
+
+    QThreadPool pool;
+    pool.setMaxThreadCount((threads > 0)? threads: QThread::idealThreadCount());
+
+    QElapsedTimer timer;
+    timer.start();
+
+    std::function<void(const QString&)> run;
+
+    // should be invoked under lock of the mutex.
+    auto schedule = [&](const QString& name) {
+        if (nodes.value(name)->mainThread) {
+            mainQueue.push_back(name);
+            condition.wakeAll();
+        } else {
+            pool.start([&run, name]() {
+                run(name);
+            });
+        }
+    };
+
+    std::function<void(const QString&)> skip = [&](const QString& name) {
+        auto& record = nodes.value(name)->record;
+        if (record.skipped)
+            return;
+
+        record.skipped = true;
+        --left;
+
+        for (const auto& dependent : dependents.value(name)) {
+            skip(dependent);
+        }
+    };
+
+    run = [&](const QString& name) {
+        Node* node = nodes.value(name);
+
+        const qint64 start = timer.nsecsElapsed();
+        const bool result = (node->init)? node->init(): true;
+        const qint64 finish = timer.nsecsElapsed();
+
+        QMutexLocker locker(&mutex);
+
+        auto thread = QThread::currentThread();
+        if (!threadIndexes.contains(thread)) {
+            threadIndexes.insert(thread, threadIndexes.size());
+        }
+
+        node->record.start = start;
+        node->record.finish = finish;
+        node->record.thread = threadIndexes.value(thread);
+        node->record.success = result;
+        --left;
+
+        if (!result) {
+            qCritical() << "Failed to initialize the service" << name;
+            success = false;
+        }
+
+        for (const auto& dependent : dependents.value(name)) {
+            if (!result) {
+                skip(dependent);
+            } else if (!--pending[dependent] && !nodes.value(dependent)->record.skipped) {
+                schedule(dependent);
+            }
+        }
+
+        condition.wakeAll();
+    };
+
+    {
+        QMutexLocker locker(&mutex);
+
+        for (const auto& name : std::as_const(_order)) {
+            if (!pending.value(name))
+                schedule(name);
+        }
+
+        while (left > 0) {
+            if (mainQueue.size()) {
+                const QString name = mainQueue.takeFirst();
+                locker.unlock();
+                run(name);
+                locker.relock();
+                continue;
+            }
+
+            condition.wait(&mutex);
+        }
+    }
+
+    pool.waitForDone();
+    _elapsed = timer.nsecsElapsed();
+
+    // the critical path ends on the service that finished last, and goes through the latest dependencies.
+    Node* last = nullptr;
+    for (auto node : std::as_const(nodes)) {
+        if (node->record.success && (!last || last->record.finish < node->record.finish))
+            last = node;
+    }
+
+    while (last) {
+        last->record.critical = true;
+
+        Node* previous = nullptr;
+        for (const auto& dependency : std::as_const(last->record.dependencies)) {
+            Node* node = nodes.value(dependency);
+            if (!previous || previous->record.finish < node->record.finish)
+                previous = node;
+        }
+
+        last = previous;
+    }
+
+    return success;
+}
+
+QList<ServiceStartupRecord> ServiceRegistry::timeline() const {
+    QList<ServiceStartupRecord> result;
+    result.reserve(_order.size());
+
+    for (const auto& name : _order) {
+        result.push_back(_nodes.value(name).record);
+    }
+
+    std::stable_sort(result.begin(), result.end(), [](const ServiceStartupRecord& left,
+                                                      const ServiceStartupRecord& right) {
+        return left.start < right.start;
+    });
+
+    return result;
+}
+
+QStringList ServiceRegistry::criticalPath() const {
+    QStringList result;
+    const auto records = timeline();
+
+    for (const auto& record : records) {
+        if (record.critical)
+            result.push_back(record.name);
+    }
+
+    return result;
+}
+
+QString ServiceRegistry::timelineReport() const {
+    auto ms = [](qint64 time) {
+        return QString::number(time / 1000000.0, 'f', 2);
+    };
+
+    auto row = [](const QString& name, const QString& start, const QString& duration,
+                  const QString& thread, const QString& status) {
+        return name.leftJustified(32) + " " + start.rightJustified(10) + " " +
+               duration.rightJustified(10) + " " + thread.rightJustified(7) + " " +
+               status.rightJustified(8) + "\n";
+    };
+
+    QString report = row("Service", "Start(ms)", "Time(ms)", "Thread", "Status");
+    qint64 sequential = 0;
+
+    const auto records = timeline();
+    for (const auto& record : records) {
+        QString status = "ok";
+        if (record.skipped) {
+            status = "skipped";
+        } else if (!record.success) {
+            status = "failed";
+        }
+
+        sequential += record.finish - record.start;
+        report += row(QString(record.critical? "* ": "  ") + record.name,
+                      ms(record.start),
+                      ms(record.finish - record.start),
+                      QString::number(record.thread),
+                      status);
+    }
+
+    report += "Total: " + ms(_elapsed) + " ms, sequential: " + ms(sequential) + " ms\n";
+    report += "Critical path: " + criticalPath().join(" -> ") + "\n";
+
+    return report;
+}
+
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef SERVICEREGISTRY_H
+#define SERVICEREGISTRY_H
+
+#include "quasarapp_global.h"
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+#include <QThread>
+#include <functional>
+#include <type_traits>
+
+namespace QuasarAppUtils {
+
+/**
+ * @brief The ServiceStartupRecord struct contains information about initialization of the one service.
+ * @see ServiceRegistry::timeline
+ */
+struct QUASARAPPSHARED_EXPORT ServiceStartupRecord {
+    /// name of the service.
+    QString name;
+    /// names of the services that should be initialized before this service.
+    QStringList dependencies;
+    /// start time of the initialization in nanoseconds from start of the registry.
+    qint64 start = 0;
+    /// finish time of the initialization in nanoseconds from start of the registry.
+    qint64 finish = 0;
+    /// index of the thread that initialized the service. 0 is the thread of the ServiceRegistry::start method.
+    int thread = 0;
+    /// true if the service was initialized successful.
+    bool success = false;
+    /// true if the service was not initialized because one of the dependencies failed.
+    bool skipped = false;
+    /// true if the service is on the critical path of the startup.
+    bool critical = false;
+};
+
+/**
+ * @brief The ServiceRegistry class initializes services in parallel with respect of them dependencies.
+ * Each service declares list of dependencies and the init function.
+ * The registry runs init functions of the independent services on the thread pool at the same time,
+ * so the startup time is equals time of the longest chain of the dependencies (critical path) instead of the sum of all services.
+ *
+ * **Example:**
+ *
+ * @code{cpp}
+ *  QuasarAppUtils::ServiceRegistry registry;
+ *  registry.addService<QuasarAppUtils::Settings>("settings");
+ *  registry.addService<MyDatabase>("database");
+ *  registry.addService<MyCache>("cache", {"settings", "database"});
+ *  registry.add("locales", []() {
+ *      return QuasarAppUtils::Locales::init({QLocale::system()}, {":/languages/"});
+ *  }, {"settings"}, true);
+ *
+ *  if (!registry.start()) {
+ *      qCritical().noquote() << registry.timelineReport();
+ *  }
+ * @endcode
+ *
+ * @note QObject services created by the addService method will be moved to the thread of the ServiceRegistry::start method.
+ *  Init functions that should work on the thread of the ServiceRegistry::start method (for example create widgets) should be added with the mainThread option.
+ * @see Service
+ */
+class QUASARAPPSHARED_EXPORT ServiceRegistry
+{
+public:
+    using InitFunction = std::function<bool()>;
+
+    ServiceRegistry();
+
+    /**
+     * @brief add This method adds the service into registry.
+     * @param name This is unique name of the service.
+     * @param init This is init function of the service. Should return true if the service initialized successful.
+     * @param dependencies This is names of the services that should be initialized before this service.
+     * @param mainThread This option forces invoke of the @a init function on the thread of the ServiceRegistry::start method.
+     * @return true if the service added else false.
+     */
+    bool add(const QString& name, const InitFunction& init,
+             const QStringList& dependencies = {}, bool mainThread = false);
+
+    /**
+     * @brief addService This method adds the @a ServiceType service that will be initialized by the Service::autoInstance method.
+     * @param name This is unique name of the service.
+     * @param dependencies This is names of the services that should be initialized before this service.
+     * @return true if the service added else false.
+     */
+    template <class ServiceType>
+    bool addService(const QString& name, const QStringList& dependencies = {}) {
+        return add(name, [this]() {
+            auto object = ServiceType::autoInstance();
+
+            if constexpr (std::is_base_of_v<QObject, std::remove_pointer_t<decltype(object)>>) {
+                // objects created on the pool thread should work on the main thread.
+                if (object && object->thread() != _startThread) {
+                    object->moveToThread(_startThread);
+                }
+            }
+
+            return object != nullptr;
+        }, dependencies);
+    }
+
+    /**
+     * @brief start This method initializes all added services and waits for finish.
+     * @param threads This is maximum count of the threads of the pool. By default uses QThread::idealThreadCount.
+     * @return true if all services initialized successful else false.
+     * @note returns false without initialization if dependencies contains cycle or unknown service.
+     */
+    bool start(int threads = 0);
+
+    /**
+     * @brief timeline This method return records of the last startup sorted by start time.
+     * @return records of the last startup.
+     */
+    QList<ServiceStartupRecord> timeline() const;
+
+    /**
+     * @brief criticalPath This method return names of the services on the longest chain of the last startup.
+     * @return names of the services from first to last.
+     */
+    QStringList criticalPath() const;
+
+    /**
+     * @brief timelineReport This method return timeline of the last startup as table.
+     * Services of the critical path marked by the '*' symbol.
+     * @return timeline of the last startup as table.
+     */
+    QString timelineReport() const;
+
+private:
+    struct Node {
+        InitFunction init;
+        bool mainThread = false;
+        ServiceStartupRecord record;
+    };
+
+    bool validate() const;
+
+    QHash<QString, Node> _nodes;
+    QStringList _order;
+    QThread* _startThread = nullptr;
+    qint64 _elapsed = 0;
+};
+
+}
+#endif // SERVICEREGISTRY_H
@@ -7,13 +7,20 @@
 
 
 #include "settings.h"
+#include "startupprofiler.h"
 #include <QSettings>
 #include <QCoreApplication>
 #include <QDebug>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QPointer>
+#include <QThreadPool>
 
 namespace QuasarAppUtils {
 
 Settings::Settings(QSettings::Format format) {
+    StartupProfiler::Scope scope("Settings::Settings");
+
     auto name = QCoreApplication::applicationName();
     auto company = QCoreApplication::organizationName();
     if (name.isEmpty()) {
@@ -27,16 +34,28 @@ Settings::Settings(QSettings::Format format) {
     _settings = new QSettings(format, QSettings::Scope::UserScope, company, name);
 }
 
+Settings::~Settings() {
+    stopWarmUp();
+}
+
 void Settings::syncImplementation() {
+    // only the first sync is a part of the startup.
+    bool measured = false;
+    std::call_once(_firstSync, [this, &measured]() {
+        StartupProfiler::Scope scope("Settings::sync");
+        _settings->sync();
+        measured = true;
+    });
+
+    if (measured) {
+        return;
+    }
+
     return _settings->sync();
 }
 
 QVariant Settings::getValueImplementation(const QString &key, const QVariant &def) {
-    if (isBool(key)) {
-        return _settings->value(key, def).toBool();
-    }
-
-    return _settings->value(key, def);
+    return castValue(key, _settings->value(key, def));
 }
 
 void Settings::setValueImplementation(const QString key, const QVariant &value) {
@@ -55,6 +74,18 @@ bool Settings::isBool(const QString &) const {
     return false;
 }
 
+QVariant Settings::castValue(const QString &key, const QVariant &value) const {
+    if (auto item = defaultsTable().find(key)) {
+        return item->cast(value);
+    }
+
+    if (isBool(key)) {
+        return value.toBool();
+    }
+
+    return value;
+}
+
 const QSet<QString> &Settings::boolOptions() const
 {
     return _boolOptions;
@@ -65,8 +96,11 @@ void Settings::setBoolOptions(const QSet<QString> &newBoolOptions)
     _boolOptions = newBoolOptions;
 }
 
-bool Settings::initService() {
-    return ISettings::initService(std::make_unique<Settings>());
+bool Settings::initService(bool warmUp) {
+    // the object is created under the lock of the service, so concurrent calls create only one object.
+    return ISettings::initService([]() -> std::unique_ptr<ISettings> {
+        return std::make_unique<Settings>();
+    }, warmUp);
 }
 
 ISettings *Settings::autoInstance() {
@@ -78,4 +112,118 @@ ISettings *Settings::autoInstance() {
     return ISettings::instance();
 }
 
+void Settings::setWatchExternalChanges(bool enable) {
+    if (enable == isWatchExternalChanges()) {
+        return;
+    }
+
+    if (!enable) {
+        delete _watcher;
+        _watcher = nullptr;
+        return;
+    }
+
+    _watcher = new QFileSystemWatcher(this);
+    connect(_watcher, &QFileSystemWatcher::fileChanged,
+            this, &Settings::handleBackendFileChanged);
+    connect(_watcher, &QFileSystemWatcher::directoryChanged,
+            this, &Settings::handleBackendFileChanged);
+
+    watchBackendFile();
+}
+
+bool Settings::isWatchExternalChanges() const {
+    return _watcher;
+}
+
+void Settings::watchBackendFile() {
+    if (!_watcher)
+        return;
+
+    const QFileInfo file(_settings->fileName());
+    const QString dir = file.absolutePath();
+
+    if (file.exists()) {
+        // QSettings replaces the file on save, so the watcher loses it and we need to add it again.
+        if (!_watcher->files().contains(file.absoluteFilePath()))
+            _watcher->addPath(file.absoluteFilePath());
+
+        if (_watcher->directories().contains(dir))
+            _watcher->removePath(dir);
+
+        return;
+    }
+
+    // the file is not created yet, so wait for it in the parent directory.
+    if (QFileInfo::exists(dir) && !_watcher->directories().contains(dir)) {
+        _watcher->addPath(dir);
+    }
+}
+
+void Settings::handleBackendFileChanged() {
+    watchBackendFile();
+
+    if (QFileInfo::exists(_settings->fileName())) {
+        reloadExternalChanges();
+    }
+}
+
+void Settings::reloadExternalChanges() {
+    if (_reloadInProgress) {
+        // collapse all changes received while reloading into one more reload.
+        _reloadRequested = true;
+        return;
+    }
+
+    auto app = QCoreApplication::instance();
+    if (!app) {
+        return;
+    }
+
+    _reloadInProgress = true;
+
+    QPointer<Settings> self = this;
+    const QString fileName = _settings->fileName();
+    const QSettings::Format format = _settings->format();
+    const QStringList keys = cachedKeys();
+
+    QThreadPool::globalInstance()->start([self, app, fileName, format, keys]() {
+        QSettings reader(fileName, format);
+        reader.sync();
+
+        QHash<QString, QVariant> values;
+        for (const auto& key: keys) {
+            if (reader.contains(key)) {
+                values.insert(key, reader.value(key));
+            }
+        }
+
+        QMetaObject::invokeMethod(app, [self, keys, values]() {
+            if (self) {
+                self->applyExternalChanges(keys, values);
+            }
+        }, Qt::QueuedConnection);
+    });
+}
+
+void Settings::applyExternalChanges(const QStringList &keys,
+                                    const QHash<QString, QVariant> &values) {
+    _reloadInProgress = false;
+
+    const auto &defaultConfig = settingsMap();
+
+    QHash<QString, QVariant> changes;
+    for (const auto& key: keys) {
+        // removed from the file keys returns to the default values.
+        changes.insert(key, castValue(key, values.value(key, defaultConfig.value(key))));
+    }
+
+    updateCache(changes);
+
+    if (_reloadRequested) {
+        _reloadRequested = false;
+        reloadExternalChanges();
+    }
+}
+
 }
@@ -13,6 +13,9 @@
 #include "isettings.h"
 #include <QSet>
 #include <QSettings>
+#include <mutex>
+
+class QFileSystemWatcher;
 
 namespace QuasarAppUtils {
 
@@ -44,6 +47,7 @@ class QUASARAPPSHARED_EXPORT Settings: public ISettings
     Q_OBJECT
 public:
     Settings(QSettings::Format format = QSettings::IniFormat);
+    ~Settings() override;
 
     // ISettings interface
     /**
@@ -64,10 +68,12 @@ public:
 
     /**
      * @brief initService This method initialize default object of the QuasarAppUtils::Settings type.
+     * @param warmUp This option starts loading of the default keys into cache on the background thread.
      * @return true if initialization finished successfull else false.
      * @see ISettings::initService
+     * @see ISettings::warmUp
      */
-    static bool initService();
+    static bool initService(bool warmUp = false);
 
     /**
      * @brief deinitService This method destroy default object of the QuasarAppUtils::Settings type.
@@ -75,6 +81,23 @@ public:
      */
     static ISettings *autoInstance();
 
+    /**
+     * @brief setWatchExternalChanges This method enables or disables watching of the settings file.
+     * When the settings file has been changed by another process, then new values will be read on the background thread
+     *  and only keys that differ from the cache will be updated and notified.
+     * @param enable This is new state of the watching.
+     * @note This works only with file based formats (for example QSettings::IniFormat).
+     * @see Settings::isWatchExternalChanges
+     */
+    void setWatchExternalChanges(bool enable);
+
+    /**
+     * @brief isWatchExternalChanges This method return true if the settings file is watched.
+     * @return true if the settings file is watched else false.
+     * @see Settings::setWatchExternalChanges
+     */
+    bool isWatchExternalChanges() const;
+
 
 protected:
 
@@ -98,8 +121,24 @@ protected:
     void setGroup(const QString&);
 
 private:
+    void watchBackendFile();
+    void handleBackendFileChanged();
+    void reloadExternalChanges();
+    void applyExternalChanges(const QStringList& keys, const QHash<QString, QVariant>& values);
+
+    /**
+     * @brief castValue This method converts the @a value to the type of the @a key.
+     * The type is taken from the compile-time defaults table, and if the key is not in the table then from the isBool method.
+     */
+    QVariant castValue(const QString& key, const QVariant& value) const;
+
     QSettings *_settings = nullptr;
     QSet<QString> _boolOptions;
+
+    QFileSystemWatcher *_watcher = nullptr;
+    std::once_flag _firstSync;
+    bool _reloadInProgress = false;
+    bool _reloadRequested = false;
 };
 
 }
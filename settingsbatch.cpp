@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "settingsbatch.h"
+#include "isettings.h"
+
+namespace QuasarAppUtils {
+
+SettingsBatch::SettingsBatch(ISettings *settings) {
+    _settings = (settings)? settings: ISettings::instance();
+
+    if (_settings) {
+        _settings->beginBatch();
+    }
+}
+
+SettingsBatch::~SettingsBatch() {
+    commit();
+}
+
+void SettingsBatch::commit() {
+    if (_settings) {
+        _settings->commit();
+        _settings.clear();
+    }
+}
+
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef SETTINGSBATCH_H
+#define SETTINGSBATCH_H
+
+#include "quasarapp_global.h"
+#include <QPointer>
+
+namespace QuasarAppUtils {
+
+class ISettings;
+
+/**
+ * @brief The SettingsBatch class is RAII wrapper of the ISettings::beginBatch and ISettings::commit methods.
+ * The batch will be started in the constructor and commited in the destructor or on the commit method.
+ *
+ * ### Example of use :
+ *
+ * @code{cpp}
+ *  {
+ *      QuasarAppUtils::SettingsBatch batch;
+ *
+ *      for (auto it = remoteConfig.begin(); it != remoteConfig.end(); ++it) {
+ *          QuasarAppUtils::ISettings::instance()->setValue(it.key(), it.value());
+ *      }
+ *
+ *  } // all changes will be saved and notified here.
+ * @endcode
+ *
+ * @see ISettings::beginBatch
+ * @see ISettings::commit
+ */
+class QUASARAPPSHARED_EXPORT SettingsBatch
+{
+public:
+    /**
+     * @brief SettingsBatch This constructor starts new batch of the @a settings object.
+     * @param settings This is settings object. By default uses the global settings object.
+     */
+    explicit SettingsBatch(ISettings* settings = nullptr);
+    ~SettingsBatch();
+
+    SettingsBatch(const SettingsBatch&) = delete;
+    SettingsBatch& operator=(const SettingsBatch&) = delete;
+
+    /**
+     * @brief commit This method commits the batch before destruction of this object.
+     * @note do nothing if batch already commited.
+     */
+    void commit();
+
+private:
+    QPointer<ISettings> _settings;
+};
+
+}
+#endif // SETTINGSBATCH_H
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "settingsbenchmark.h"
+#include "memorysettings.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QRandomGenerator>
+#include <QSemaphore>
+#include <QThread>
+#include <algorithm>
+#include <atomic>
+
+namespace QuasarAppUtils {
+
+double SettingsBenchmarkResult::operationsPerSecond() const {
+    if (!elapsed)
+        return 0;
+
+    return operations * 1000000000.0 / elapsed;
+}
+
+SettingsBenchmark::SettingsBenchmark(const Factory &factory) {
+    _factory = factory;
+
+    if (!_factory) {
+        _factory = []() {
+            return std::make_unique<MemorySettings>();
+        };
+    }
+}
+
+SettingsBenchmarkResult SettingsBenchmark::run(const SettingsBenchmarkOptions &options) const {
+    const int threadsCount = std::max(options.threads, 1);
+    const int keysCount = std::max(options.keys, 1);
+    const int operations = std::max(options.operations, 0);
+
+    QStringList keys;
+    keys.reserve(keysCount);
+    for (int i = 0; i < keysCount; ++i) {
+        keys.push_back(QString("benchmark/key%0").arg(i));
+    }
+
+    const auto settings = _factory();
+    if (!settings) {
+        qCritical() << "The settings benchmark factory returned null object.";
+        return {options, 0, 0};
+    }
+
+    for (const auto& key : std::as_const(keys)) {
+        settings->getValue(key);
+    }
+
+    // keys will be created before measure, so only settings layer will be measured.
+    // each thread has own miss keys, so the miss of one thread will not be the hit of other thread.
+    QList<QStringList> missKeys;
+    for (int i = 0; i < threadsCount; ++i) {
+        QStringList threadMissKeys;
+        threadMissKeys.reserve(operations);
+        for (int j = 0; j < operations; ++j) {
+            threadMissKeys.push_back(QString("benchmark/miss%0/%1").arg(i).arg(j));
+        }
+
+        missKeys.push_back(threadMissKeys);
+    }
+
+    // all threads work with one settings object like the ISettings::instance users,
+    // the cache of the settings is not thread-safe, so each operation is serialized.
+    ISettings* object = settings.get();
+    QMutex lock;
+    std::atomic<qint64> lockWait{0};
+
+    QSemaphore start;
+    QList<QThread*> threads;
+    for (int i = 0; i < threadsCount; ++i) {
+        const QStringList& threadMissKeys = std::as_const(missKeys)[i];
+
+        threads.push_back(QThread::create([object, &lock, &lockWait, &keys, &threadMissKeys, &start, &options, operations, i]() {
+            QRandomGenerator random(i + 1);
+            QElapsedTimer wait;
+            qint64 threadLockWait = 0;
+            start.acquire();
+
+            for (int j = 0; j < operations; ++j) {
+                const QString& key = keys[random.bounded(keys.size())];
+                const bool write = random.generateDouble() < options.writeRatio;
+                const bool hit = write || random.generateDouble() < options.hitRatio;
+
+                wait.start();
+                QMutexLocker locker(&lock);
+                threadLockWait += wait.nsecsElapsed();
+
+                if (write) {
+                    object->setValue(key, j);
+                } else if (hit) {
+                    object->getValue(key);
+                } else {
+                    object->getValue(threadMissKeys[j]);
+                }
+            }
+
+            lockWait += threadLockWait;
+        }));
+
+        threads.last()->start();
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    start.release(threadsCount);
+
+    for (auto thread : std::as_const(threads)) {
+        thread->wait();
+        delete thread;
+    }
+
+    return {options, qint64(threadsCount) * operations, timer.nsecsElapsed(), lockWait.load()};
+}
+
+QList<SettingsBenchmarkResult> SettingsBenchmark::run(const QList<int> &threads,
+                                                      const QList<double> &hitRatios,
+                                                      const SettingsBenchmarkOptions &options) const {
+    QList<SettingsBenchmarkResult> results;
+
+    for (int threadsCount : threads) {
+        for (double hitRatio : hitRatios) {
+            auto runOptions = options;
+            runOptions.threads = threadsCount;
+            runOptions.hitRatio = hitRatio;
+
+            results.push_back(run(runOptions));
+        }
+    }
+
+    return results;
+}
+
+QString SettingsBenchmark::report(const QList<SettingsBenchmarkResult> &results) {
+    auto row = [](const QString& threads, const QString& hitRatio, const QString& writeRatio,
+                  const QString& operations, const QString& time, const QString& throughput,
+                  const QString& lockWait) {
+        return threads.rightJustified(8) + " " + hitRatio.rightJustified(10) + " " +
+               writeRatio.rightJustified(10) + " " + operations.rightJustified(12) + " " +
+               time.rightJustified(12) + " " + throughput.rightJustified(14) + " " +
+               lockWait.rightJustified(14) + "\n";
+    };
+
+    QString report = row("Threads", "Hit ratio", "Writes", "Operations", "Time(ms)", "Ops/s", "Lock wait(ms)");
+    for (const auto& result : results) {
+        report += row(QString::number(result.options.threads),
+                      QString::number(result.options.hitRatio, 'f', 2),
+                      QString::number(result.options.writeRatio, 'f', 2),
+                      QString::number(result.operations),
+                      QString::number(result.elapsed / 1000000),
+                      QString::number(qint64(result.operationsPerSecond())),
+                      QString::number(result.lockWait / 1000000));
+    }
+
+    return report;
+}
+
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef SETTINGSBENCHMARK_H
+#define SETTINGSBENCHMARK_H
+
+#include "quasarapp_global.h"
+#include <QList>
+#include <QString>
+#include <functional>
+#include <memory>
+
+namespace QuasarAppUtils {
+
+class ISettings;
+
+/**
+ * @brief The SettingsBenchmarkOptions struct contains parameters of the one run of the settings benchmark.
+ */
+struct QUASARAPPSHARED_EXPORT SettingsBenchmarkOptions {
+    /// count of the threads.
+    int threads = 1;
+    /// count of the operations on each thread.
+    int operations = 100000;
+    /// part of the reads that finds value in the cache (0 - 1).
+    double hitRatio = 0.9;
+    /// part of the writes in all operations (0 - 1).
+    double writeRatio = 0.1;
+    /// count of the keys that will be read before measure.
+    int keys = 1000;
+};
+
+/**
+ * @brief The SettingsBenchmarkResult struct contains result of the one run of the settings benchmark.
+ */
+struct QUASARAPPSHARED_EXPORT SettingsBenchmarkResult {
+    /// options of the run.
+    SettingsBenchmarkOptions options;
+    /// count of the operations of the all threads.
+    qint64 operations = 0;
+    /// time of the run in nanoseconds.
+    qint64 elapsed = 0;
+    /// total time in nanoseconds that the all threads waited for the lock of the shared settings object.
+    qint64 lockWait = 0;
+
+    /**
+     * @brief operationsPerSecond This method return throughput of the run.
+     */
+    double operationsPerSecond() const;
+};
+
+/**
+ * @brief The SettingsBenchmark class measures throughput of the ISettings::getValue and ISettings::setValue methods.
+ * All threads of the benchmark work with one settings object created by the factory, like users of the ISettings::instance object.
+ * The ISettings object is not thread-safe, so operations of the threads (with latency of the backend) are serialized by the lock.
+ * So the throughput measures the serialized path and does not grow with count of the threads,
+ *  and the time that threads waited for the lock is reported separately (see SettingsBenchmarkResult::lockWait).
+ * Before measure the settings object reads the warm keys, after that reads choose warm key with the hitRatio probability and new key otherwise.
+ *
+ * **Example:**
+ *
+ * @code{cpp}
+ *  QuasarAppUtils::SettingsBenchmark benchmark([]() {
+ *      auto settings = std::make_unique<QuasarAppUtils::MemorySettings>();
+ *      settings->setLatency(QuasarAppUtils::SettingsOperation::Get, 100, 20);
+ *      return settings;
+ *  });
+ *
+ *  auto results = benchmark.run({1, 2, 4, 8}, {0.5, 0.9, 0.99});
+ *  qInfo().noquote() << QuasarAppUtils::SettingsBenchmark::report(results);
+ * @endcode
+ *
+ * @see MemorySettings
+ */
+class QUASARAPPSHARED_EXPORT SettingsBenchmark
+{
+public:
+    using Factory = std::function<std::unique_ptr<ISettings>()>;
+
+    /**
+     * @brief SettingsBenchmark This constructor creates benchmark.
+     * @param factory This is factory of the settings objects. By default creates MemorySettings without latency.
+     */
+    explicit SettingsBenchmark(const Factory& factory = {});
+
+    /**
+     * @brief run This method runs benchmark with the @a options.
+     * @param options This is parameters of the run.
+     * @return result of the run.
+     */
+    SettingsBenchmarkResult run(const SettingsBenchmarkOptions& options) const;
+
+    /**
+     * @brief run This method runs benchmark for each combination of the @a threads and @a hitRatios.
+     * @param threads This is list of the threads counts.
+     * @param hitRatios This is list of the cache hit ratios.
+     * @param options This is base parameters of the runs.
+     * @return results of the all runs.
+     */
+    QList<SettingsBenchmarkResult> run(const QList<int>& threads,
+                                       const QList<double>& hitRatios,
+                                       const SettingsBenchmarkOptions& options = {}) const;
+
+    /**
+     * @brief report This method return results as table.
+     * @param results This is results of the benchmark.
+     * @return table of the results.
+     */
+    static QString report(const QList<SettingsBenchmarkResult>& results);
+
+private:
+    Factory _factory;
+};
+
+}
+#endif // SETTINGSBENCHMARK_H
@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "settingsdefaults.h"
+
+namespace QuasarAppUtils {
+
+QVariant SettingDefault::value() const {
+    switch (type) {
+    case SettingType::Bool: return boolValue;
+    case SettingType::Int: return intValue;
+    case SettingType::Double: return doubleValue;
+    case SettingType::String: return QString::fromUtf8(stringValue);
+    }
+
+    return {};
+}
+
+QVariant SettingDefault::cast(const QVariant &value) const {
+    switch (type) {
+    case SettingType::Bool: return value.toBool();
+    case SettingType::Int: return value.toLongLong();
+    case SettingType::Double: return value.toDouble();
+    case SettingType::String: return value.toString();
+    }
+
+    return value;
+}
+
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef SETTINGSDEFAULTS_H
+#define SETTINGSDEFAULTS_H
+
+#include "quasarapp_global.h"
+#include "perfecthash.h"
+#include <QVariant>
+
+namespace QuasarAppUtils {
+
+/**
+ * @brief The SettingType enum contains types of the values of the compile-time settings table.
+ */
+enum class SettingType {
+    /// boolean value.
+    Bool,
+    /// integer value.
+    Int,
+    /// floating point value.
+    Double,
+    /// string value.
+    String
+};
+
+/**
+ * @brief The SettingDefault struct is one item of the compile-time settings table.
+ * Use the boolSetting, intSetting, doubleSetting and stringSetting functions for create it.
+ * @see makeSettingsDefaults
+ */
+struct QUASARAPPSHARED_EXPORT SettingDefault {
+    /// key of the setting in utf8.
+    const char* key = nullptr;
+    /// crc32 hash of the key.
+    uint32_t hash = 0;
+    /// type of the setting.
+    SettingType type = SettingType::String;
+
+    bool boolValue = false;
+    qint64 intValue = 0;
+    double doubleValue = 0;
+    const char* stringValue = nullptr;
+
+    /**
+     * @brief value This method return default value of the setting.
+     * @return default value of the setting.
+     */
+    QVariant value() const;
+
+    /**
+     * @brief cast This method converts the @a value to the type of this setting.
+     * @param value This is value that should be converted.
+     * @return converted value.
+     */
+    QVariant cast(const QVariant& value) const;
+};
+
+/**
+ * @brief SettingsDefaultsView is not template view of the SettingsDefaults table.
+ * @see SettingsDefaults::view
+ */
+using SettingsDefaultsView = PerfectHashView<SettingDefault>;
+
+/**
+ * @brief The SettingsDefaults class is compile-time table of the default settings.
+ * The table uses perfect hash (see the PerfectHashTable class), so lookup of the key is one probe without collisions.
+ * The table should be created by the makeSettingsDefaults function in the constexpr context.
+ *
+ * **Example:**
+ *
+ * @code{cpp}
+ * static constexpr auto defaults = QuasarAppUtils::makeSettingsDefaults(
+ *     QuasarAppUtils::stringSetting("colorTheme", "#ff6b01"),
+ *     QuasarAppUtils::boolSetting("shareName", true),
+ *     QuasarAppUtils::intSetting("APIVersion", 2));
+ *
+ * static_assert(defaults.find(LITIRAL_CRC32("shareName"))->type == QuasarAppUtils::SettingType::Bool);
+ *
+ * MySettings::MySettings() {
+ *     setDefaultsTable(defaults.view());
+ * }
+ * @endcode
+ *
+ * @note Keys should be unique, else compilation fails.
+ * @see ISettings::setDefaultsTable
+ */
+template <size_t N>
+using SettingsDefaults = PerfectHashTable<SettingDefault, N>;
+
+/**
+ * @brief makeSettingsDefaults This function creates compile-time table of the default settings.
+ * @param items This is list of settings created by the boolSetting, intSetting, doubleSetting and stringSetting functions.
+ * @return table of the default settings.
+ * @see SettingsDefaults
+ */
+template <class... Items>
+constexpr SettingsDefaults<sizeof...(Items)> makeSettingsDefaults(const Items&... items) {
+    return SettingsDefaults<sizeof...(Items)>(std::array<SettingDefault, sizeof...(Items)>{items...});
+}
+
+/**
+ * @brief boolSetting This function creates boolean item of the settings table.
+ * @param key This is key of the setting.
+ * @param value This is default value of the setting.
+ */
+template <size_t N>
+constexpr SettingDefault boolSetting(const char (&key)[N], bool value) {
+    return SettingDefault{key, calculateCrc32(key, N - 1), SettingType::Bool, value, 0, 0, nullptr};
+}
+
+/**
+ * @brief intSetting This function creates integer item of the settings table.
+ * @param key This is key of the setting.
+ * @param value This is default value of the setting.
+ */
+template <size_t N>
+constexpr SettingDefault intSetting(const char (&key)[N], qint64 value) {
+    return SettingDefault{key, calculateCrc32(key, N - 1), SettingType::Int, false, value, 0, nullptr};
+}
+
+/**
+ * @brief doubleSetting This function creates floating point item of the settings table.
+ * @param key This is key of the setting.
+ * @param value This is default value of the setting.
+ */
+template <size_t N>
+constexpr SettingDefault doubleSetting(const char (&key)[N], double value) {
+    return SettingDefault{key, calculateCrc32(key, N - 1), SettingType::Double, false, 0, value, nullptr};
+}
+
+/**
+ * @brief stringSetting This function creates string item of the settings table.
+ * @param key This is key of the setting.
+ * @param value This is default value of the setting in utf8.
+ */
+template <size_t N>
+constexpr SettingDefault stringSetting(const char (&key)[N], const char* value) {
+    return SettingDefault{key, calculateCrc32(key, N - 1), SettingType::String, false, 0, 0, value};
+}
+
+}
+#endif // SETTINGSDEFAULTS_H
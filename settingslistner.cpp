@@ -7,26 +7,124 @@
 
 #include "isettings.h"
 #include "settingslistner.h"
+#include <QTimer>
 
 namespace QuasarAppUtils {
 
-SettingsListner::SettingsListner() {
+SettingsListner::SettingsListner(): SettingsListner(QStringList{}) {
 
-    auto settings = ISettings::instance();
-    if (settings) {
+}
+
+SettingsListner::SettingsListner(const QStringList &keys, const QStringList &prefixes) {
 
-        auto listner = [this](QString key, QVariant val){
-            this->handleSettingsChanged(key, val);
-        };
+    // drop the keys and prefixes that covered by other prefixes for avoid duplicate notifications.
+    auto isCovered = [&prefixes](const QString& value, const QString& exclude) {
+        for (const auto& prefix: prefixes) {
+            if (prefix != exclude && value.startsWith(prefix))
+                return true;
+        }
+        return false;
+    };
 
-        _listnerConnection = QObject::connect(settings,
-                                              &ISettings::valueChanged,
-                                              listner);
+    for (const auto& prefix: prefixes) {
+        if (!_prefixes.contains(prefix) && !isCovered(prefix, prefix))
+            _prefixes.push_back(prefix);
+    }
+
+    for (const auto& key: keys) {
+        if (!_keys.contains(key) && !isCovered(key, {}))
+            _keys.push_back(key);
+    }
+
+    _settings = ISettings::instance();
+    if (_settings) {
+        _settings->addListner(this, _keys, _prefixes);
     }
 }
 
 SettingsListner::~SettingsListner() {
-    QObject::disconnect(_listnerConnection);
+    // after this the notify method can not be invoked by other threads, so the timer can be removed without lock.
+    if (_settings) {
+        _settings->removeListner(this, _keys, _prefixes);
+    }
+
+    // pending queued flushes will be dropped together with the timer object.
+    delete _flushTimer;
+}
+
+void SettingsListner::handleSettingsBatch(const QVariantHash &values) {
+    for (auto it = values.cbegin(); it != values.cend(); ++it) {
+        handleSettingsChanged(it.key(), it.value());
+    }
+}
+
+void SettingsListner::setNotifyMode(SettingsNotifyMode mode, int interval) {
+    QMutexLocker locker(&_mutex);
+    _mode = mode;
+
+    if (_mode == SettingsNotifyMode::Sync) {
+        // the timer is removed under lock, so the notify method can not post start request to the removed timer.
+        delete _flushTimer;
+        _flushTimer = nullptr;
+        locker.unlock();
+
+        // deliver changes that received before switch of the mode.
+        flush();
+        return;
+    }
+
+    if (!_flushTimer) {
+        _flushTimer = new QTimer();
+        _flushTimer->setSingleShot(true);
+        QObject::connect(_flushTimer, &QTimer::timeout, _flushTimer, [this]() {
+            flush();
+        });
+    }
+
+    _flushTimer->setInterval(qMax(interval, 0));
+}
+
+SettingsNotifyMode SettingsListner::notifyMode() const {
+    QMutexLocker locker(&_mutex);
+    return _mode;
+}
+
+void SettingsListner::notify(const QString &key, const QVariant &value) {
+    QMutexLocker locker(&_mutex);
+    if (_mode == SettingsNotifyMode::Sync || !_flushTimer) {
+        locker.unlock();
+        handleSettingsChanged(key, value);
+        return;
+    }
+
+    _pending.insert(key, value);
+
+    if (_flushScheduled) {
+        return;
+    }
+
+    _flushScheduled = true;
+
+    // the timer can be started only from the thread of the listner, so post start request into the listner's event loop.
+    auto timer = _flushTimer;
+    QMetaObject::invokeMethod(timer, [timer]() {
+        if (!timer->isActive())
+            timer->start();
+    }, Qt::QueuedConnection);
+}
+
+void SettingsListner::flush() {
+    QVariantHash values;
+
+    {
+        QMutexLocker locker(&_mutex);
+        values.swap(_pending);
+        _flushScheduled = false;
+    }
+
+    if (values.size()) {
+        handleSettingsBatch(values);
+    }
 }
 
 }
@@ -8,13 +8,31 @@
 #ifndef SETTINGSLISTNER_H
 #define SETTINGSLISTNER_H
 
+#include <QAtomicInt>
+#include <QMutex>
+#include <QPointer>
 #include <QString>
+#include <QStringList>
 #include <QVariant>
 #include "quasarapp_global.h"
 
 
+class QTimer;
+
 namespace QuasarAppUtils {
 
+class ISettings;
+
+/**
+ * @brief The SettingsNotifyMode enum contains modes of the delivering settings changes to the SettingsListner objects.
+ */
+enum class SettingsNotifyMode {
+    /// Listner will be invoked immediately in the thread of the ISettings::setValue caller for each change.
+    Sync,
+    /// Changes will be coalesced by key and delivered by batches in the thread of the listner with limited rate.
+    Async
+};
+
 /**
  * @brief The SettingsListner class is listner of the ISettings global object.
  * The SettingsListner class is abstrct class and contains only one method for hendling settings changes.
@@ -34,12 +52,48 @@ namespace QuasarAppUtils {
  *
  *  };
  * @endcode
+ *
+ * If your listner works with a few keys only then register it for this keys or key prefixes.
+ * In this case the listner will be invoked only when one of the registered keys has been changed.
+ *
+ * @code{cpp}
+ *  class MyClass : protected QuasarAppUtils::SettingsListner {
+ *  public:
+ *      MyClass(): QuasarAppUtils::SettingsListner({"shareName"}, {"network/"}) {}
+ *  protected:
+ *      void handleSettingsChanged(const QString& key, const QVariant& value) override {
+ *          // key is "shareName" or starts with "network/"
+ *      }
+ *
+ *  };
+ * @endcode
+ * @note Changes commited by the ISettings::commit method will be delivered as a separate handleSettingsChanged call for each changed key.
+ *
+ * If your listner needs only latest values of the settings then use the SettingsNotifyMode::Async mode.
+ * In this mode changes will be coalesced and delivered on the event loop of the listner's thread not often than the selected interval.
+ *
+ * @code{cpp}
+ *  MyClass::MyClass() {
+ *      setNotifyMode(QuasarAppUtils::SettingsNotifyMode::Async, 100);
+ *  }
+ * @endcode
  * @see ISettings
  */
 class QUASARAPPSHARED_EXPORT SettingsListner
 {
 public:
+    /**
+     * @brief SettingsListner This constructor creates listner of the all settings keys.
+     */
     SettingsListner();
+
+    /**
+     * @brief SettingsListner This constructor creates listner of the @a keys and keys that starts with the @a prefixes only.
+     * @param keys This is list of the listened keys.
+     * @param prefixes This is list of the listened key prefixes.
+     * @note If both lists are empty then listner will be receive changes of the all keys.
+     */
+    explicit SettingsListner(const QStringList& keys, const QStringList& prefixes = {});
     virtual ~SettingsListner();
 
 protected:
@@ -51,8 +105,53 @@ protected:
      */
     virtual void handleSettingsChanged(const QString& key,
                                        const QVariant& value) = 0;
+
+    /**
+     * @brief handleSettingsBatch This method will be invoked in the SettingsNotifyMode::Async mode with all changes coalesced since the last invoke.
+     * @param values This is map of the changed keys and them latest values.
+     * The default implementation invokes the handleSettingsChanged method for each changed key.
+     */
+    virtual void handleSettingsBatch(const QVariantHash& values);
+
+    /**
+     * @brief setNotifyMode This method sets mode of the delivering settings changes.
+     * @param mode This is new delivering mode.
+     * @param interval This is minimal interval in msec between invokes of the handleSettingsBatch method. Used only in the SettingsNotifyMode::Async mode.
+     * @note In the SettingsNotifyMode::Async mode changes will be delivered in the thread that invoke this method, so this thread should have a running event loop.
+     *  The listner should be destroyed in the same thread.
+     * @see SettingsListner::notifyMode
+     */
+    void setNotifyMode(SettingsNotifyMode mode, int interval = 0);
+
+    /**
+     * @brief notifyMode This method return current mode of the delivering settings changes.
+     * @return current mode of the delivering settings changes.
+     * @see SettingsListner::setNotifyMode
+     */
+    SettingsNotifyMode notifyMode() const;
+
 private:
-    QMetaObject::Connection _listnerConnection;
+    /**
+     * @brief notify This method invoked by the ISettings object when one of the listened key has been changed.
+     */
+    void notify(const QString& key, const QVariant& value);
+    void flush();
+
+    QPointer<ISettings> _settings;
+    QStringList _keys;
+    QStringList _prefixes;
+
+    // guards the mode, timer and pending changes, because the notify method is invoked in the thread of the ISettings::setValue caller.
+    mutable QMutex _mutex;
+    SettingsNotifyMode _mode = SettingsNotifyMode::Sync;
+    QTimer* _flushTimer = nullptr;
+    QVariantHash _pending;
+    bool _flushScheduled = false;
+
+    // count of the deliveries of the changes that run right now, see the ISettings::notifyListners method.
+    QAtomicInt _inFlight = 0;
+
+    friend class ISettings;
 };
 
 }
@@ -0,0 +1,560 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "sharedsettings.h"
+
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+
+#include "crc32constexper.h"
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDebug>
+#include <QSet>
+#include <QThread>
+
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace QuasarAppUtils {
+
+#define SHARED_SETTINGS_MAGIC 0x51415353 // QASS
+#define SHARED_SETTINGS_VERSION 1
+#define SHARED_SETTINGS_KEY_SIZE 256
+#define SHARED_SETTINGS_LOG_SIZE 256
+#define SHARED_SETTINGS_ALIGN 64
+// count of the reads of the slot in the write state before the reader takes the write lock.
+#define SHARED_SETTINGS_READ_ATTEMPTS 1000
+
+namespace {
+
+struct SegmentHeader {
+    std::atomic<uint32_t> magic;
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t slotSize;
+    pthread_mutex_t writeMutex;
+
+    // number of the last change, used as a futex word for notifications.
+    std::atomic<uint32_t> changes;
+
+    // ring of the indexes of the changed slots, the change with number N stored in the N % SHARED_SETTINGS_LOG_SIZE item.
+    std::atomic<uint32_t> changeLog[SHARED_SETTINGS_LOG_SIZE];
+};
+
+struct SlotHeader {
+    // odd value means that the slot is being written right now.
+    std::atomic<uint32_t> sequence;
+    std::atomic<uint32_t> keyHash;
+    std::atomic<uint32_t> keySize;
+    std::atomic<uint32_t> valueSize;
+};
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free,
+              "The futex requires lock free 32 bit atomic");
+
+constexpr size_t align(size_t size) {
+    return (size + SHARED_SETTINGS_ALIGN - 1) / SHARED_SETTINGS_ALIGN * SHARED_SETTINGS_ALIGN;
+}
+
+constexpr size_t headerSize() {
+    return align(sizeof(SegmentHeader));
+}
+
+long futex(std::atomic<uint32_t>* word, int op, uint32_t value, const timespec* timeout = nullptr) {
+    return syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), op, value, timeout, nullptr, 0);
+}
+
+SegmentHeader* segmentHeader(uchar* memory) {
+    return reinterpret_cast<SegmentHeader*>(memory);
+}
+
+SlotHeader* slotAt(uchar* memory, uint32_t index) {
+    const auto header = segmentHeader(memory);
+    return reinterpret_cast<SlotHeader*>(memory + headerSize() + size_t(index) * header->slotSize);
+}
+
+uchar* slotData(SlotHeader* slot) {
+    return reinterpret_cast<uchar*>(slot) + sizeof(SlotHeader);
+}
+
+uint32_t valueCapacity(const SegmentHeader* header) {
+    return header->slotSize - sizeof(SlotHeader) - SHARED_SETTINGS_KEY_SIZE;
+}
+
+/*
+ * Invokes the reader function until it read a consistent state of the slot.
+ * Returns false if the slot is not consistent after all attempts (for example the writer died while writing).
+ */
+template <class Reader>
+bool readConsistent(SlotHeader* slot, Reader reader) {
+    for (int attempt = 0; attempt < SHARED_SETTINGS_READ_ATTEMPTS; ++attempt) {
+        const uint32_t begin = slot->sequence.load(std::memory_order_acquire);
+        if (begin & 1) {
+            QThread::yieldCurrentThread();
+            continue;
+        }
+
+        reader();
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->sequence.load(std::memory_order_relaxed) == begin)
+            return true;
+    }
+
+    return false;
+}
+
+QString defaultSegmentName() {
+    auto name = QCoreApplication::applicationName();
+    auto company = QCoreApplication::organizationName();
+    if (name.isEmpty()) {
+        name = "QuasarAppUtils";
+    }
+
+    if (company.isEmpty()) {
+        company = "QuasarApp";
+    }
+
+    return QString("/%0.%1.settings").arg(company, name).replace(' ', '_');
+}
+
+}
+
+SharedSettings::SharedSettings(const QString &name, int capacity, int maxValueSize) {
+    _name = (name.isEmpty())? defaultSegmentName(): name;
+
+    if (!mapSegment(qMax(capacity, 1), qMax(maxValueSize, 1))) {
+        qCritical() << "Failed to open the shared settings segment:" << _name;
+        return;
+    }
+
+    _lastChange = segmentHeader(_memory)->changes.load(std::memory_order_acquire);
+
+    _watcher = QThread::create([this]() {
+        watchChanges();
+    });
+    _watcher->start();
+}
+
+SharedSettings::~SharedSettings() {
+    stopWarmUp();
+
+    if (_watcher) {
+        _stop.storeRelease(1);
+        futex(&segmentHeader(_memory)->changes, FUTEX_WAKE, INT_MAX);
+
+        _watcher->wait();
+        delete _watcher;
+    }
+
+    if (_memory) {
+        munmap(_memory, _size);
+    }
+}
+
+bool SharedSettings::isValid() const {
+    return _memory;
+}
+
+const QString &SharedSettings::name() const {
+    return _name;
+}
+
+bool SharedSettings::unlink(const QString &name) {
+    return shm_unlink(name.toUtf8().constData()) == 0;
+}
+
+bool SharedSettings::mapSegment(int capacity, int maxValueSize) {
+    const QByteArray name = _name.toUtf8();
+
+    bool created = true;
+    int fd = shm_open(name.constData(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0 && errno == EEXIST) {
+        created = false;
+        fd = shm_open(name.constData(), O_RDWR, 0600);
+    }
+
+    if (fd < 0) {
+        return false;
+    }
+
+    if (created) {
+        const uint32_t slotSize = align(sizeof(SlotHeader) + SHARED_SETTINGS_KEY_SIZE + maxValueSize);
+        _size = headerSize() + size_t(capacity) * slotSize;
+
+        if (ftruncate(fd, _size) != 0) {
+            close(fd);
+            shm_unlink(name.constData());
+            return false;
+        }
+
+        void* memory = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+
+        if (memory == MAP_FAILED) {
+            shm_unlink(name.constData());
+            return false;
+        }
+
+        _memory = static_cast<uchar*>(memory);
+
+        // ftruncate fills the segment by zeros, so all slots are empty already.
+        auto header = segmentHeader(_memory);
+        header->version = SHARED_SETTINGS_VERSION;
+        header->capacity = capacity;
+        header->slotSize = slotSize;
+
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+        pthread_mutex_init(&header->writeMutex, &attr);
+        pthread_mutexattr_destroy(&attr);
+
+        header->magic.store(SHARED_SETTINGS_MAGIC, std::memory_order_release);
+        return true;
+    }
+
+    // the segment is created by another process, so wait while it will be initialized.
+    struct stat info{};
+    for (int i = 0; i < 1000; ++i) {
+        if (fstat(fd, &info) == 0 && size_t(info.st_size) >= headerSize())
+            break;
+
+        usleep(1000);
+    }
+
+    if (size_t(info.st_size) < headerSize()) {
+        close(fd);
+        return false;
+    }
+
+    _size = info.st_size;
+    void* memory = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (memory == MAP_FAILED) {
+        return false;
+    }
+
+    _memory = static_cast<uchar*>(memory);
+    auto header = segmentHeader(_memory);
+
+    for (int i = 0; i < 1000 && header->magic.load(std::memory_order_acquire) != SHARED_SETTINGS_MAGIC; ++i) {
+        usleep(1000);
+    }
+
+    if (header->magic.load(std::memory_order_acquire) != SHARED_SETTINGS_MAGIC ||
+        header->version != SHARED_SETTINGS_VERSION ||
+        headerSize() + size_t(header->capacity) * header->slotSize > _size) {
+
+        qCritical() << "The shared settings segment has wrong format:" << _name;
+        munmap(_memory, _size);
+        _memory = nullptr;
+        return false;
+    }
+
+    if (header->capacity != uint32_t(capacity) || valueCapacity(header) < uint32_t(maxValueSize)) {
+        qWarning() << "The shared settings segment" << _name << "created with other parameters."
+                   << "Will be used capacity:" << header->capacity << "max value size:" << valueCapacity(header);
+    }
+
+    return true;
+}
+
+bool SharedSettings::lockWriter() const {
+    auto header = segmentHeader(_memory);
+
+    int result = pthread_mutex_lock(&header->writeMutex);
+    if (result == EOWNERDEAD) {
+        // the previous writer died while writing, so release slots that it left in the write state.
+        for (uint32_t i = 0; i < header->capacity; ++i) {
+            auto slot = slotAt(_memory, i);
+            uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+            if (sequence & 1) {
+                slot->sequence.store(sequence + 1, std::memory_order_release);
+            }
+        }
+
+        pthread_mutex_consistent(&header->writeMutex);
+        return true;
+    }
+
+    return result == 0;
+}
+
+void SharedSettings::unlockWriter() const {
+    pthread_mutex_unlock(&segmentHeader(_memory)->writeMutex);
+}
+
+template <class Reader>
+bool SharedSettings::readLocked(Reader reader) const {
+    // writers can't change slots under this lock, and the lock repairs slots of the died writer.
+    if (!lockWriter()) {
+        qCritical() << "Failed to lock the shared settings segment:" << _name;
+        return false;
+    }
+
+    reader();
+    unlockWriter();
+
+    return true;
+}
+
+bool SharedSettings::findValue(const QByteArray &key, uint32_t hash, QByteArray *value) const {
+    const auto header = segmentHeader(_memory);
+    const uint32_t valueLimit = valueCapacity(header);
+
+    for (uint32_t i = 0; i < header->capacity; ++i) {
+        auto slot = slotAt(_memory, (hash + i) % header->capacity);
+
+        bool empty = false;
+        bool found = false;
+        auto read = [&]() {
+            const uint32_t keySize = slot->keySize.load(std::memory_order_relaxed);
+            empty = !keySize;
+            found = !empty &&
+                    slot->keyHash.load(std::memory_order_relaxed) == hash &&
+                    keySize == uint32_t(key.size()) &&
+                    memcmp(slotData(slot), key.constData(), keySize) == 0;
+
+            if (found && value) {
+                const uint32_t valueSize = qMin(slot->valueSize.load(std::memory_order_relaxed), valueLimit);
+                value->resize(valueSize);
+                memcpy(value->data(), slotData(slot) + SHARED_SETTINGS_KEY_SIZE, valueSize);
+            }
+        };
+
+        if (!readConsistent(slot, read) && !readLocked(read))
+            return false;
+
+        if (empty)
+            return false;
+
+        if (found)
+            return true;
+    }
+
+    return false;
+}
+
+bool SharedSettings::readEntry(uint32_t index, QByteArray *key, QByteArray *value) const {
+    const auto header = segmentHeader(_memory);
+    const uint32_t valueLimit = valueCapacity(header);
+    auto slot = slotAt(_memory, index);
+
+    bool empty = false;
+    auto read = [&]() {
+        const uint32_t keySize = qMin<uint32_t>(slot->keySize.load(std::memory_order_relaxed), SHARED_SETTINGS_KEY_SIZE);
+        empty = !keySize;
+        if (empty)
+            return;
+
+        const uint32_t valueSize = qMin(slot->valueSize.load(std::memory_order_relaxed), valueLimit);
+        key->resize(keySize);
+        memcpy(key->data(), slotData(slot), keySize);
+        value->resize(valueSize);
+        memcpy(value->data(), slotData(slot) + SHARED_SETTINGS_KEY_SIZE, valueSize);
+    };
+
+    if (!readConsistent(slot, read) && !readLocked(read))
+        return false;
+
+    return !empty;
+}
+
+int SharedSettings::findSlotForWrite(const QByteArray &key, uint32_t hash) const {
+    const auto header = segmentHeader(_memory);
+
+    // invoked under the write lock, so slots can't be changed by other processes.
+    for (uint32_t i = 0; i < header->capacity; ++i) {
+        const uint32_t index = (hash + i) % header->capacity;
+        auto slot = slotAt(_memory, index);
+        const uint32_t keySize = slot->keySize.load(std::memory_order_relaxed);
+
+        if (!keySize)
+            return index;
+
+        if (slot->keyHash.load(std::memory_order_relaxed) == hash &&
+            keySize == uint32_t(key.size()) &&
+            memcmp(slotData(slot), key.constData(), keySize) == 0) {
+            return index;
+        }
+    }
+
+    return -1;
+}
+
+void SharedSettings::syncImplementation() {
+    // all values are written into the shared memory immediately.
+}
+
+QVariant SharedSettings::getValueImplementation(const QString &key, const QVariant &def) {
+    if (!_memory) {
+        return def;
+    }
+
+    const QByteArray keyData = key.toUtf8();
+    QByteArray valueData;
+    if (!findValue(keyData, calculateCrc32(keyData.constData(), keyData.size()), &valueData)) {
+        return def;
+    }
+
+    QVariant result;
+    QDataStream stream(valueData);
+    stream >> result;
+
+    return result;
+}
+
+void SharedSettings::setValueImplementation(const QString key, const QVariant &value) {
+    if (!_memory) {
+        return;
+    }
+
+    const auto header = segmentHeader(_memory);
+    const QByteArray keyData = key.toUtf8();
+
+    QByteArray valueData;
+    {
+        QDataStream stream(&valueData, QIODevice::WriteOnly);
+        stream << value;
+    }
+
+    if (keyData.size() > SHARED_SETTINGS_KEY_SIZE || uint32_t(valueData.size()) > valueCapacity(header)) {
+        qCritical() << "The" << key << "setting is too large for the shared settings segment. It will not be saved.";
+        return;
+    }
+
+    const uint32_t hash = calculateCrc32(keyData.constData(), keyData.size());
+
+    if (!lockWriter()) {
+        qCritical() << "Failed to lock the shared settings segment:" << _name;
+        return;
+    }
+
+    const int index = findSlotForWrite(keyData, hash);
+    if (index < 0) {
+        unlockWriter();
+        qCritical() << "The shared settings segment is full. The" << key << "setting will not be saved.";
+        return;
+    }
+
+    auto slot = slotAt(_memory, index);
+    const uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot->keyHash.store(hash, std::memory_order_relaxed);
+    slot->keySize.store(keyData.size(), std::memory_order_relaxed);
+    slot->valueSize.store(valueData.size(), std::memory_order_relaxed);
+    memcpy(slotData(slot), keyData.constData(), keyData.size());
+    memcpy(slotData(slot) + SHARED_SETTINGS_KEY_SIZE, valueData.constData(), valueData.size());
+
+    slot->sequence.store(sequence + 2, std::memory_order_release);
+
+    const uint32_t change = header->changes.load(std::memory_order_relaxed) + 1;
+    header->changeLog[change % SHARED_SETTINGS_LOG_SIZE].store(index, std::memory_order_relaxed);
+    header->changes.store(change, std::memory_order_release);
+
+    unlockWriter();
+
+    futex(&header->changes, FUTEX_WAKE, INT_MAX);
+}
+
+QHash<QString, QVariant> SharedSettings::defaultSettings() {
+    return {};
+}
+
+void SharedSettings::watchChanges() {
+    auto header = segmentHeader(_memory);
+    uint32_t seen = _lastChange;
+
+    // the timeout protects from lost wake ups, changes are delivered by futex wake up in usual case.
+    const timespec timeout{0, 200 * 1000 * 1000};
+
+    while (!_stop.loadAcquire()) {
+        const uint32_t current = header->changes.load(std::memory_order_acquire);
+        if (current != seen) {
+            seen = current;
+            scheduleApplyChanges();
+        }
+
+        futex(&header->changes, FUTEX_WAIT, current, &timeout);
+    }
+}
+
+void SharedSettings::scheduleApplyChanges() {
+    if (!_applyScheduled.testAndSetOrdered(0, 1)) {
+        return;
+    }
+
+    QMetaObject::invokeMethod(this, [this]() {
+        _applyScheduled.storeRelease(0);
+        applyChanges();
+    }, Qt::QueuedConnection);
+}
+
+void SharedSettings::applyChanges() {
+    const auto header = segmentHeader(_memory);
+    const uint32_t current = header->changes.load(std::memory_order_acquire);
+
+    if (current == _lastChange) {
+        return;
+    }
+
+    // read only changed slots if the change log still contains all changes since last apply.
+    bool fullScan = current - _lastChange >= SHARED_SETTINGS_LOG_SIZE;
+    QSet<uint32_t> indexes;
+    if (!fullScan) {
+        for (uint32_t change = _lastChange + 1; change != current + 1; ++change) {
+            indexes.insert(header->changeLog[change % SHARED_SETTINGS_LOG_SIZE].load(std::memory_order_relaxed));
+        }
+
+        // the log can be overwritten by writers while we read it.
+        fullScan = header->changes.load(std::memory_order_acquire) - _lastChange >= SHARED_SETTINGS_LOG_SIZE;
+    }
+
+    _lastChange = current;
+
+    if (fullScan) {
+        indexes.clear();
+        for (uint32_t i = 0; i < header->capacity; ++i) {
+            indexes.insert(i);
+        }
+    }
+
+    QHash<QString, QVariant> values;
+    QByteArray key;
+    QByteArray valueData;
+    for (uint32_t index: std::as_const(indexes)) {
+        if (index >= header->capacity || !readEntry(index, &key, &valueData))
+            continue;
+
+        QVariant value;
+        QDataStream stream(valueData);
+        stream >> value;
+
+        values.insert(QString::fromUtf8(key), value);
+    }
+
+    updateCache(values);
+}
+
+}
+
+#endif
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef SHAREDSETTINGS_H
+#define SHAREDSETTINGS_H
+
+#include "quasarapp_global.h"
+#include "isettings.h"
+
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+
+namespace QuasarAppUtils {
+
+/**
+ * @brief The SharedSettings class is settings backend that keeps values in the POSIX shared memory segment.
+ * All processes that open the segment with the same name work with the same values,
+ *  so a change made in one process will be available in the others immediately.
+ *
+ * Each value is stored in the own slot of the segment. Readers use seqlock protocol and never lock,
+ *  writers are serialized by the robust process shared mutex.
+ * After each write the change counter of the segment will be incremented and all waiters of it (futex) will be woken up,
+ *  so other processes update own caches and emit the ISettings::valueChanged signal for changed keys only.
+ *
+ * Example of initialisation :
+ *
+ *  @code{cpp}
+ *     QuasarAppUtils::ISettings::initService(std::make_unique<QuasarAppUtils::SharedSettings>());
+ *  @endcode
+ *
+ * @note The segment is not saved on the hard disk and lives until reboot or the SharedSettings::unlink method call.
+ * @note This backend is available only on Linux.
+ * @see ISettings
+ */
+class QUASARAPPSHARED_EXPORT SharedSettings: public ISettings
+{
+    Q_OBJECT
+public:
+
+    /**
+     * @brief SharedSettings This constructor opens or creates the shared memory segment.
+     * @param name This is name of the shared memory segment. By default uses name based on the organization and application names.
+     * @param capacity This is maximum count of the keys in the segment.
+     * @param maxValueSize This is maximum size in bytes of the one serialized value.
+     * @note If the segment already created by another process then the @a capacity and @a maxValueSize will be taken from the segment.
+     */
+    SharedSettings(const QString& name = {}, int capacity = 1024, int maxValueSize = 1024);
+    ~SharedSettings() override;
+
+    /**
+     * @brief isValid This method return true if the shared memory segment opened successful.
+     * @return true if the segment opened else false.
+     */
+    bool isValid() const;
+
+    /**
+     * @brief name This method return name of the shared memory segment.
+     * @return name of the shared memory segment.
+     */
+    const QString& name() const;
+
+    /**
+     * @brief unlink This method removes the shared memory segment with @a name. Processes that already open this segment can still use it.
+     * @param name This is name of the removed segment.
+     * @return true if the segment removed successful else false.
+     */
+    static bool unlink(const QString& name);
+
+protected:
+    void syncImplementation() override;
+    QVariant getValueImplementation(const QString &key, const QVariant &def) override;
+    void setValueImplementation(const QString key, const QVariant &value) override;
+    QHash<QString, QVariant> defaultSettings() override;
+
+private:
+    bool mapSegment(int capacity, int maxValueSize);
+    bool lockWriter() const;
+    void unlockWriter() const;
+
+    /**
+     * @brief readLocked This method invokes the @a reader under the write lock. Used when the slot stays in the write state too long.
+     */
+    template <class Reader>
+    bool readLocked(Reader reader) const;
+
+    bool findValue(const QByteArray& key, uint32_t hash, QByteArray* value) const;
+    bool readEntry(uint32_t index, QByteArray* key, QByteArray* value) const;
+    int findSlotForWrite(const QByteArray& key, uint32_t hash) const;
+
+    void watchChanges();
+    void scheduleApplyChanges();
+    void applyChanges();
+
+    QString _name;
+    uchar* _memory = nullptr;
+    size_t _size = 0;
+
+    QThread* _watcher = nullptr;
+    QAtomicInt _stop = 0;
+    QAtomicInt _applyScheduled = 0;
+    uint32_t _lastChange = 0;
+};
+
+}
+
+#endif
+
+#endif // SHAREDSETTINGS_H
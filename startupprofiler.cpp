@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "startupprofiler.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QThread>
+#include <algorithm>
+#include <cstdlib>
+
+namespace QuasarAppUtils {
+
+// protection from unlimited growth if the finish method is never invoked.
+#define STARTUP_PROFILER_MAX_PHASES 10000
+
+struct StartupProfilerData {
+    StartupProfilerData() {
+        timer.start();
+    }
+
+    QMutex mutex;
+    QElapsedTimer timer;
+    QList<StartupPhase> phases;
+    QString tracePath;
+    // the flag is checked by each scope, so it is readed without the mutex.
+    QAtomicInt active = 1;
+    bool reportScheduled = false;
+};
+
+Q_GLOBAL_STATIC(StartupProfilerData, _data)
+
+static void printStartupProfile() {
+    if (_data.isDestroyed()) {
+        return;
+    }
+
+    qInfo().noquote() << StartupProfiler::report();
+
+    QString path;
+    {
+        QMutexLocker locker(&_data->mutex);
+        path = _data->tracePath;
+    }
+
+    if (path.size() && StartupProfiler::writeChromeTrace(path)) {
+        qInfo().noquote() << "The startup trace saved into" << path;
+    }
+}
+
+StartupProfiler::Scope::Scope(const char *name, const QString &detail) {
+    if (!isActive())
+        return;
+
+    _name = name;
+    _detail = detail;
+    _start = now();
+}
+
+StartupProfiler::Scope::~Scope() {
+    if (_start < 0)
+        return;
+
+    record(QString::fromUtf8(_name), _detail, _start, now());
+}
+
+bool StartupProfiler::isActive() {
+    if (_data.isDestroyed())
+        return false;
+
+    return _data->active.loadRelaxed();
+}
+
+void StartupProfiler::finish() {
+    if (_data.isDestroyed())
+        return;
+
+    _data->active.storeRelaxed(0);
+}
+
+void StartupProfiler::disable() {
+    if (_data.isDestroyed())
+        return;
+
+    QMutexLocker locker(&_data->mutex);
+    _data->active.storeRelaxed(0);
+    _data->phases.clear();
+    _data->phases.squeeze();
+}
+
+void StartupProfiler::record(const QString &name, const QString &detail, qint64 start, qint64 finish) {
+    if (_data.isDestroyed())
+        return;
+
+    QMutexLocker locker(&_data->mutex);
+    if (!_data->active.loadRelaxed() || _data->phases.size() >= STARTUP_PROFILER_MAX_PHASES)
+        return;
+
+    _data->phases.push_back(StartupPhase{name, detail, start, finish - start,
+                                         quint64(quintptr(QThread::currentThreadId()))});
+}
+
+qint64 StartupProfiler::now() {
+    if (_data.isDestroyed())
+        return 0;
+
+    return _data->timer.nsecsElapsed();
+}
+
+QList<StartupPhase> StartupProfiler::phases() {
+    if (_data.isDestroyed())
+        return {};
+
+    QMutexLocker locker(&_data->mutex);
+    return _data->phases;
+}
+
+QString StartupProfiler::report() {
+    struct Summary {
+        int count = 0;
+        qint64 total = 0;
+        qint64 max = 0;
+    };
+
+    const auto items = phases();
+
+    QHash<QString, Summary> summaries;
+    qint64 end = 0;
+    for (const auto& phase : items) {
+        auto& summary = summaries[phase.name];
+        summary.count++;
+        summary.total += phase.duration;
+        summary.max = std::max(summary.max, phase.duration);
+
+        end = std::max(end, phase.start + phase.duration);
+    }
+
+    QStringList names = summaries.keys();
+    std::sort(names.begin(), names.end(), [&summaries](const QString& left, const QString& right) {
+        return summaries.value(left).total > summaries.value(right).total;
+    });
+
+    auto ms = [](qint64 time) {
+        return QString::number(time / 1000000.0, 'f', 2);
+    };
+
+    auto row = [](const QString& name, const QString& count, const QString& total, const QString& max) {
+        return name.leftJustified(40) + " " + count.rightJustified(8) + " " +
+               total.rightJustified(12) + " " + max.rightJustified(12) + "\n";
+    };
+
+    QString report = row("Phase", "Count", "Total(ms)", "Max(ms)");
+    for (const auto& name : std::as_const(names)) {
+        const auto summary = summaries.value(name);
+        report += row(name, QString::number(summary.count), ms(summary.total), ms(summary.max));
+    }
+
+    report += "End of the last phase: " + ms(end) + " ms\n";
+
+    return report;
+}
+
+QByteArray StartupProfiler::chromeTrace() {
+    const auto items = phases();
+    const qint64 pid = QCoreApplication::applicationPid();
+
+    QJsonArray events;
+    for (const auto& phase : items) {
+        QJsonObject event;
+        event["name"] = phase.name;
+        event["cat"] = "startup";
+        event["ph"] = "X";
+        // chrome trace uses microseconds.
+        event["ts"] = phase.start / 1000.0;
+        event["dur"] = phase.duration / 1000.0;
+        event["pid"] = pid;
+        event["tid"] = qint64(phase.thread);
+
+        if (phase.detail.size()) {
+            event["args"] = QJsonObject{{"detail", phase.detail}};
+        }
+
+        events.push_back(event);
+    }
+
+    return QJsonDocument(QJsonObject{{"traceEvents", events},
+                                     {"displayTimeUnit", "ms"}}).toJson(QJsonDocument::Compact);
+}
+
+bool StartupProfiler::writeChromeTrace(const QString &path) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCritical() << "Failed to write the startup trace:" << path << file.errorString();
+        return false;
+    }
+
+    file.write(chromeTrace());
+    return true;
+}
+
+void StartupProfiler::reportAtExit(const QString &tracePath) {
+    if (_data.isDestroyed())
+        return;
+
+    {
+        QMutexLocker locker(&_data->mutex);
+        _data->tracePath = tracePath;
+
+        if (_data->reportScheduled)
+            return;
+
+        _data->reportScheduled = true;
+    }
+
+    if (QCoreApplication::instance()) {
+        qAddPostRoutine(printStartupProfile);
+    } else {
+        std::atexit(printStartupProfile);
+    }
+}
+
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef STARTUPPROFILER_H
+#define STARTUPPROFILER_H
+
+#include "quasarapp_global.h"
+#include <QList>
+#include <QString>
+
+namespace QuasarAppUtils {
+
+/**
+ * @brief The StartupPhase struct contains information about one measured phase of the startup.
+ */
+struct QUASARAPPSHARED_EXPORT StartupPhase {
+    /// name of the phase.
+    QString name;
+    /// additional information (for example path of the loaded file).
+    QString detail;
+    /// start time in nanoseconds from the first use of the profiler.
+    qint64 start = 0;
+    /// duration of the phase in nanoseconds.
+    qint64 duration = 0;
+    /// id of the thread that executed the phase.
+    quint64 thread = 0;
+};
+
+/**
+ * @brief The StartupProfiler class collects durations of the startup phases of the application.
+ * The library measures the Params::parseParams, Params::parseAvailableOptions, Locales::init (with search and loading of the qm files),
+ *  Settings construction and first sync, QALogger::init and initialization of each Service object.
+ * Own phases can be measured by the StartupProfiler::Scope object.
+ *
+ * Use the -startupProfile option for print per-phase breakdown and save the chrome trace json (see chrome://tracing) on exit of the application.
+ *
+ * @code{bash}
+ * myApp -startupProfile startup.json
+ * @endcode
+ *
+ * **Example of measure own phase:**
+ *
+ * @code{cpp}
+ *  {
+ *      QuasarAppUtils::StartupProfiler::Scope scope("Database::open", path);
+ *      database.open(path);
+ *  }
+ * @endcode
+ *
+ * @note Phases are collected only until the StartupProfiler::finish method will be invoked.
+ *  If the -startupProfile option is not passed then the Params::parseParams method disables the profiler and drops phases of the parsing.
+ */
+class QUASARAPPSHARED_EXPORT StartupProfiler
+{
+public:
+
+    /**
+     * @brief The Scope class measures duration of the phase from construction to destruction.
+     */
+    class QUASARAPPSHARED_EXPORT Scope {
+    public:
+        /**
+         * @brief Scope This constructor starts measure of the phase.
+         * @param name This is name of the phase. Should be alive until destruction of the scope (string literal).
+         * @param detail This is additional information about the phase.
+         */
+        explicit Scope(const char* name, const QString& detail = {});
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* _name = nullptr;
+        QString _detail;
+        qint64 _start = -1;
+    };
+
+    /**
+     * @brief isActive This method return true if the profiler collects phases.
+     */
+    static bool isActive();
+
+    /**
+     * @brief finish This method stops collect of the phases. Invoke it when startup of the application finished.
+     */
+    static void finish();
+
+    /**
+     * @brief disable This method stops collect of the phases and drops already collected phases.
+     * @note The Params class invokes this method when the -startupProfile option is not passed.
+     */
+    static void disable();
+
+    /**
+     * @brief record This method adds the finished phase.
+     * @param name This is name of the phase.
+     * @param detail This is additional information about the phase.
+     * @param start This is start time of the phase. See the StartupProfiler::now method.
+     * @param finish This is finish time of the phase.
+     */
+    static void record(const QString& name, const QString& detail, qint64 start, qint64 finish);
+
+    /**
+     * @brief now This method return time in nanoseconds from the first use of the profiler.
+     */
+    static qint64 now();
+
+    /**
+     * @brief phases This method return all collected phases.
+     */
+    static QList<StartupPhase> phases();
+
+    /**
+     * @brief report This method return per-phase breakdown as table.
+     * Phases with same name are summarized.
+     */
+    static QString report();
+
+    /**
+     * @brief chromeTrace This method return collected phases in the chrome trace json format.
+     */
+    static QByteArray chromeTrace();
+
+    /**
+     * @brief writeChromeTrace This method saves the chrome trace json into the @a path file.
+     * @param path This is path to the trace file.
+     * @return true if the file saved successful.
+     */
+    static bool writeChromeTrace(const QString& path);
+
+    /**
+     * @brief reportAtExit This method prints the report and saves the chrome trace on exit of the application.
+     * @param tracePath This is path to the trace file. If path is empty then only the report will be printed.
+     * @note The Params class invokes this method when the -startupProfile option is passed.
+     */
+    static void reportAtExit(const QString& tracePath);
+};
+
+}
+#endif // STARTUPPROFILER_H
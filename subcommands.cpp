@@ -0,0 +1,16 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "subcommands.h"
+
+namespace QuasarAppUtils {
+
+Help::Options SubcommandDefinition::toHelp() const {
+    return {{QString::fromUtf8(key), QString::fromUtf8(description)}};
+}
+
+}
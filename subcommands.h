@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef SUBCOMMANDS_H
+#define SUBCOMMANDS_H
+
+#include "quasarapp_global.h"
+#include "optionsregistry.h"
+#include "perfecthash.h"
+
+namespace QuasarAppUtils {
+
+/**
+ * @brief SubcommandHandler This is function that executes the subcommand. The parsed options are available by the Params class.
+ * @return exit code of the subcommand.
+ * @see Params::execSubcommand
+ */
+using SubcommandHandler = int (*)();
+
+/**
+ * @brief The SubcommandDefinition struct is one item of the compile-time subcommands table.
+ * Use the subcommand function for create it.
+ * @see makeSubcommands
+ */
+struct QUASARAPPSHARED_EXPORT SubcommandDefinition {
+    /// name of the subcommand as it is written in the command line (for example "build").
+    const char* key = nullptr;
+    /// crc32 hash of the name.
+    uint32_t hash = 0;
+    /// description of the subcommand in the help.
+    const char* description = "";
+    /// available options of the subcommand. Only these options are validated when the subcommand is used.
+    OptionsRegistryView options = {};
+    /// function that executes the subcommand. Can be nullptr.
+    SubcommandHandler handler = nullptr;
+
+    /**
+     * @brief toHelp This method converts this definition to the help line.
+     * @return The Help::Options set with one line.
+     */
+    Help::Options toHelp() const;
+};
+
+/**
+ * @brief subcommand This function creates item of the subcommands table.
+ * @param name This is name of the subcommand as it is written in the command line.
+ * @param description This is description of the subcommand.
+ * @param options This is view of the compile-time registry with options of the subcommand.
+ * @param handler This is function that executes the subcommand.
+ */
+template <size_t N>
+constexpr SubcommandDefinition subcommand(const char (&name)[N],
+                                          const char* description = "",
+                                          const OptionsRegistryView& options = {},
+                                          SubcommandHandler handler = nullptr) {
+    return SubcommandDefinition{name, calculateCrc32(name, N - 1), description, options, handler};
+}
+
+/**
+ * @brief SubcommandsView is not template view of the Subcommands table.
+ * @see Params::parseParams
+ */
+using SubcommandsView = PerfectHashView<SubcommandDefinition>;
+
+/**
+ * @brief The Subcommands class is compile-time table of the subcommands (for example tool build ..., tool run ...).
+ * The first argument of the command line is dispatched by one probe of the perfect hash,
+ *  and only options of the selected subcommand are validated and used in the help.
+ *
+ * **Example:**
+ *
+ * @code{cpp}
+ *  static constexpr auto buildOptions = QuasarAppUtils::makeOptionsRegistry(
+ *      QuasarAppUtils::option("Build", "-threads", QuasarAppUtils::OptionType::Int, "(count)", "Sets count of the threads"));
+ *
+ *  static constexpr auto commands = QuasarAppUtils::makeSubcommands(
+ *      QuasarAppUtils::subcommand("build", "Builds the project", buildOptions.view(), &build),
+ *      QuasarAppUtils::subcommand("clean", "Removes build files", {}, &clean));
+ *
+ *  if (!QuasarAppUtils::Params::parseParams(argc, argv, commands.view())) {
+ *      QuasarAppUtils::Params::showHelp();
+ *      return 1;
+ *  }
+ *
+ *  return QuasarAppUtils::Params::execSubcommand();
+ * @endcode
+ *
+ * @note Names should be unique, else compilation fails.
+ */
+template <size_t N>
+using Subcommands = PerfectHashTable<SubcommandDefinition, N>;
+
+/**
+ * @brief makeSubcommands This function creates compile-time table of the subcommands.
+ * @param items This is list of subcommands created by the subcommand function.
+ * @return table of the subcommands.
+ */
+template <class... Items>
+constexpr Subcommands<sizeof...(Items)> makeSubcommands(const Items&... items) {
+    return Subcommands<sizeof...(Items)>(std::array<SubcommandDefinition, sizeof...(Items)>{items...});
+}
+
+}
+
+#endif // SUBCOMMANDS_H
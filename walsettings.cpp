@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "walsettings.h"
+#include "crc32constexper.h"
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
+#include <QtEndian>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace QuasarAppUtils {
+
+#define WAL_SNAPSHOT_MAGIC 0x51415357 // QASW
+#define WAL_RECORD_HEADER_SIZE 8
+#define WAL_STREAM_VERSION QDataStream::Qt_6_0
+
+WalSettings::WalSettings(const QString &path, qint64 checkpointSize) {
+    _path = path;
+    if (_path.isEmpty()) {
+        _path = QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation) + "/settings";
+    }
+
+    _checkpointSize = checkpointSize;
+
+    QDir().mkpath(QFileInfo(_path).absolutePath());
+
+    recover();
+
+    _log.setFileName(logPath());
+    if (!_log.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qCritical() << "Failed to open the settings log:" << logPath() << _log.errorString();
+    }
+}
+
+WalSettings::~WalSettings() {
+    stopWarmUp();
+
+    if (_checkpointThread) {
+        _checkpointThread->wait();
+        delete _checkpointThread;
+    }
+
+    if (_log.isOpen()) {
+        _log.flush();
+    }
+}
+
+const QString &WalSettings::path() const {
+    return _path;
+}
+
+void WalSettings::checkpoint() {
+    if (_checkpointThread) {
+        if (_checkpointThread->isRunning()) {
+            return;
+        }
+
+        delete _checkpointThread;
+        _checkpointThread = nullptr;
+    }
+
+    // move records of the current log aside, new records will be written into the new log.
+    _log.close();
+
+    if (QFile::exists(oldLogPath())) {
+        // the previous checkpoint failed, so keep its records together with the current.
+        QFile oldLog(oldLogPath());
+        QFile log(logPath());
+        if (oldLog.open(QIODevice::WriteOnly | QIODevice::Append) && log.open(QIODevice::ReadOnly)) {
+            oldLog.write(log.readAll());
+            oldLog.close();
+            log.remove();
+        }
+    } else {
+        QFile::rename(logPath(), oldLogPath());
+    }
+
+    if (!_log.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qCritical() << "Failed to open the settings log:" << logPath() << _log.errorString();
+    }
+
+    const auto values = _values;
+    const QString snapshot = snapshotPath();
+    const QString oldLog = oldLogPath();
+
+    _checkpointThread = QThread::create([values, snapshot, oldLog]() {
+        if (writeSnapshot(snapshot, values)) {
+            QFile::remove(oldLog);
+        }
+    });
+    _checkpointThread->start(QThread::LowPriority);
+}
+
+void WalSettings::syncImplementation() {
+    if (!_log.isOpen()) {
+        return;
+    }
+
+    _log.flush();
+
+#ifdef Q_OS_WIN
+    _commit(_log.handle());
+#else
+    fsync(_log.handle());
+#endif
+}
+
+QVariant WalSettings::getValueImplementation(const QString &key, const QVariant &def) {
+    return _values.value(key, def);
+}
+
+void WalSettings::setValueImplementation(const QString key, const QVariant &value) {
+    auto it = _values.find(key);
+    if (it != _values.end() && *it == value) {
+        return;
+    }
+
+    _values.insert(key, value);
+    appendRecord(key, value);
+
+    if (_log.size() >= _checkpointSize) {
+        checkpoint();
+    }
+}
+
+QHash<QString, QVariant> WalSettings::defaultSettings() {
+    return {};
+}
+
+void WalSettings::recover() {
+    loadSnapshot();
+
+    // the old log exists only if the last checkpoint was not finished, its records are older than records of the current log.
+    replay(oldLogPath());
+    replay(logPath());
+}
+
+bool WalSettings::loadSnapshot() {
+    QFile file(snapshotPath());
+    if (!file.exists()) {
+        return true;
+    }
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to open the settings snapshot:" << snapshotPath() << file.errorString();
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(WAL_STREAM_VERSION);
+
+    quint32 magic = 0;
+    quint32 crc = 0;
+    QByteArray payload;
+    stream >> magic >> crc >> payload;
+
+    if (stream.status() != QDataStream::Ok || magic != WAL_SNAPSHOT_MAGIC ||
+        calculateCrc32(payload.constData(), payload.size()) != crc) {
+        qCritical() << "The settings snapshot is corrupted and will be ignored:" << snapshotPath();
+        return false;
+    }
+
+    QDataStream values(payload);
+    values.setVersion(WAL_STREAM_VERSION);
+    values >> _values;
+
+    return values.status() == QDataStream::Ok;
+}
+
+void WalSettings::replay(const QString &logPath) {
+    QFile file(logPath);
+    if (!file.exists()) {
+        return;
+    }
+
+    if (!file.open(QIODevice::ReadWrite)) {
+        qCritical() << "Failed to open the settings log:" << logPath << file.errorString();
+        return;
+    }
+
+    const QByteArray data = file.readAll();
+    qsizetype valid = 0;
+
+    while (valid + WAL_RECORD_HEADER_SIZE <= data.size()) {
+        const quint32 size = qFromLittleEndian<quint32>(data.constData() + valid);
+        const quint32 crc = qFromLittleEndian<quint32>(data.constData() + valid + 4);
+
+        if (valid + WAL_RECORD_HEADER_SIZE + qsizetype(size) > data.size())
+            break;
+
+        const char* payloadData = data.constData() + valid + WAL_RECORD_HEADER_SIZE;
+        if (calculateCrc32(payloadData, size) != crc)
+            break;
+
+        const QByteArray payload = QByteArray::fromRawData(payloadData, size);
+        QDataStream stream(payload);
+        stream.setVersion(WAL_STREAM_VERSION);
+
+        QString key;
+        QVariant value;
+        stream >> key >> value;
+
+        if (stream.status() != QDataStream::Ok)
+            break;
+
+        _values.insert(key, value);
+        valid += WAL_RECORD_HEADER_SIZE + size;
+    }
+
+    if (valid < data.size()) {
+        qWarning() << "The settings log contains broken tail, it will be dropped:" << logPath
+                   << "dropped bytes:" << data.size() - valid;
+        file.resize(valid);
+    }
+}
+
+void WalSettings::appendRecord(const QString &key, const QVariant &value) {
+    if (!_log.isOpen()) {
+        return;
+    }
+
+    QByteArray payload;
+    {
+        QDataStream stream(&payload, QIODevice::WriteOnly);
+        stream.setVersion(WAL_STREAM_VERSION);
+        stream << key << value;
+    }
+
+    QByteArray record(WAL_RECORD_HEADER_SIZE, 0);
+    qToLittleEndian<quint32>(payload.size(), record.data());
+    qToLittleEndian<quint32>(calculateCrc32(payload.constData(), payload.size()), record.data() + 4);
+    record += payload;
+
+    // one write call per record, so a crash can tear only the last record.
+    _log.write(record);
+    _log.flush();
+}
+
+bool WalSettings::writeSnapshot(const QString &snapshotPath, const QHash<QString, QVariant> &values) {
+    QByteArray payload;
+    {
+        QDataStream stream(&payload, QIODevice::WriteOnly);
+        stream.setVersion(WAL_STREAM_VERSION);
+        stream << values;
+    }
+
+    QSaveFile file(snapshotPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCritical() << "Failed to write the settings snapshot:" << snapshotPath << file.errorString();
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(WAL_STREAM_VERSION);
+    stream << quint32(WAL_SNAPSHOT_MAGIC)
+           << quint32(calculateCrc32(payload.constData(), payload.size()))
+           << payload;
+
+    // QSaveFile replaces the old snapshot atomically.
+    return file.commit();
+}
+
+QString WalSettings::snapshotPath() const {
+    return _path + ".snapshot";
+}
+
+QString WalSettings::logPath() const {
+    return _path + ".wal";
+}
+
+QString WalSettings::oldLogPath() const {
+    return _path + ".wal.old";
+}
+
+}
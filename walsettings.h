@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026-2026 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef WALSETTINGS_H
+#define WALSETTINGS_H
+
+#include "quasarapp_global.h"
+#include "isettings.h"
+#include <QFile>
+
+namespace QuasarAppUtils {
+
+/**
+ * @brief The WalSettings class is durable settings backend based on the write-ahead log.
+ * Each change of the value appends one small record to the log file, so the write cost does not depend on the size of the configuration.
+ * When the log becomes bigger than the checkpoint size, all values will be saved into the compact snapshot file on the background thread and the log will be started again.
+ *
+ * Each record and the snapshot are protected by the crc32 checksum (see the calculateCrc32 function).
+ * On start the snapshot will be loaded and only records of the log written after the last checkpoint will be replayed.
+ * A torn record at the end of the log (for example after crash while writing) will be dropped.
+ *
+ * Files of the backend:
+ *  - path.snapshot - values saved on the last checkpoint.
+ *  - path.wal - records written after the last checkpoint.
+ *  - path.wal.old - records of the checkpoint in progress.
+ *
+ * Example of initialisation :
+ *
+ *  @code{cpp}
+ *     QuasarAppUtils::ISettings::initService(std::make_unique<QuasarAppUtils::WalSettings>());
+ *  @endcode
+ *
+ * @note The ISettings::sync method forces writing of the log onto the disk (fsync).
+ * @see ISettings
+ */
+class QUASARAPPSHARED_EXPORT WalSettings: public ISettings
+{
+    Q_OBJECT
+public:
+
+    /**
+     * @brief WalSettings This constructor loads the snapshot and replays the log.
+     * @param path This is base path of the backend files. By default uses the settings file in the application config location.
+     * @param checkpointSize This is size of the log in bytes after that the checkpoint will be started.
+     */
+    WalSettings(const QString& path = {}, qint64 checkpointSize = 1024 * 1024);
+    ~WalSettings() override;
+
+    /**
+     * @brief path This method return base path of the backend files.
+     * @return base path of the backend files.
+     */
+    const QString& path() const;
+
+    /**
+     * @brief checkpoint This method starts saving of the all values into snapshot on the background thread.
+     * @note do nothing if the previous checkpoint is still in progress.
+     */
+    void checkpoint();
+
+protected:
+    void syncImplementation() override;
+    QVariant getValueImplementation(const QString &key, const QVariant &def) override;
+    void setValueImplementation(const QString key, const QVariant &value) override;
+    QHash<QString, QVariant> defaultSettings() override;
+
+private:
+    void recover();
+    bool loadSnapshot();
+    void replay(const QString& logPath);
+    void appendRecord(const QString& key, const QVariant& value);
+    static bool writeSnapshot(const QString& snapshotPath, const QHash<QString, QVariant>& values);
+
+    QString snapshotPath() const;
+    QString logPath() const;
+    QString oldLogPath() const;
+
+    QString _path;
+    qint64 _checkpointSize = 0;
+    QFile _log;
+    QHash<QString, QVariant> _values;
+    QThread* _checkpointThread = nullptr;
+};
+
+}
+#endif // WALSETTINGS_H